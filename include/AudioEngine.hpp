@@ -0,0 +1,72 @@
+// AudioEngine.hpp
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "SpscQueue.hpp"
+
+// Sound effects for gameplay events. All buffers are loaded (or synthesized
+// when no file is present) by start(), and a fixed pool of voices is owned by
+// a background mixer thread. play() pushes a small request into a lock-free
+// ring, so triggering a cue never loads or allocates; it only takes a lock
+// to wake the mixer, which sleeps while there is nothing to play.
+class AudioEngine {
+public:
+    enum class Cue : std::uint8_t {
+        MOVE,
+        COLLISION,
+        PICKUP,
+        LEVEL_COMPLETE,
+        COUNT
+    };
+
+    static const std::size_t VOICE_COUNT = 16;
+    static const std::size_t QUEUE_SIZE = 256;
+
+    AudioEngine();
+    ~AudioEngine();
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    // Game thread only. Returns false if the request was dropped.
+    bool play(Cue cue, float volume = 100.0f, float pitch = 1.0f);
+
+    void setMuted(bool muted) { this->muted.store(muted, std::memory_order_relaxed); }
+    bool isMuted() const { return muted.load(std::memory_order_relaxed); }
+    std::uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Request {
+        Cue cue;
+        float volume;
+        float pitch;
+    };
+
+    struct Voice {
+        sf::Sound sound;
+        Cue cue;
+        std::uint64_t startedAt;    // Request sequence number, for stealing the oldest
+    };
+
+    void loadBuffers();
+    void mixerLoop();
+    void assignVoice(const Request& request);
+
+    std::array<sf::SoundBuffer, static_cast<std::size_t>(Cue::COUNT)> buffers;
+    std::array<Voice, VOICE_COUNT> voices;
+    SpscQueue<Request, QUEUE_SIZE> requests;
+    std::atomic<bool> running;
+    std::atomic<bool> muted;
+    std::atomic<std::uint32_t> dropped;
+    std::atomic<bool> sleeping; // Mixer is waiting, or about to wait, on wake
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::uint64_t sequence;     // Mixer thread only
+    std::thread mixer;
+};
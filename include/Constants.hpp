@@ -6,4 +6,10 @@ namespace GameConstants {
     const float BASE_CELL_SIZE = 30.0f;
     const float MINIMAP_SCALE = 0.5f;
     const float POWERUP_DURATION = 10.0f;
+    const int FOG_VIEW_RADIUS = 6;
+    const int SIMULATION_TICK_RATE = 120;
+    const int REWIND_TICKS = 1200;  // 10 seconds of simulation ticks
+    // Grid size from which the hint uses HPA*. Current difficulties top out at
+    // 31x31, so this is reserved for future large-grid modes.
+    const int HPA_MIN_CELLS = 256 * 256;
 }
\ No newline at end of file
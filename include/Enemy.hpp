@@ -7,14 +7,26 @@
 class Enemy {
 public:
     Enemy(Point startPos, float speed);
+    // Restarts the enemy at a new position, reusing its patrol path storage.
+    void reset(Point startPos, float speed);
     void update(float deltaTime);
     void draw(sf::RenderWindow& window, float cellSize) const;
+    static void drawAt(sf::RenderWindow& window, const Point& position, float cellSize);
     bool checkCollision(const Point& playerPos) const;
 
+    // Getters
+    const Point& getPosition() const { return position; }
+    float getSpeed() const { return speed; }
+    float getPathIndex() const { return currentPathIndex; }
+
+    // Jumps to a point along the patrol path (used when rewinding).
+    void setPathIndex(float pathIndex);
+
 private:
     Point position;
     std::vector<Point> patrolPath;
     float speed;
     float currentPathIndex;
     void generatePatrolPath();
+    void updatePosition();
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+// FieldOfView.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Point.hpp"
+
+// Recursive shadowcasting over the '#'/' ' maze grid. Visible and explored
+// cells are kept in bitsets; an update only touches cells inside the view
+// radius, so its cost does not depend on the maze size. The cells whose
+// visibility changed during the last update are reported for incremental
+// redraws.
+class FieldOfView {
+public:
+    FieldOfView();
+
+    void reset(int width, int height);
+    void update(const std::vector<std::vector<char>>& maze, const Point& origin, int radius);
+
+    bool isVisible(int x, int y) const { return inBounds(x, y) && test(visible, x, y); }
+    bool isExplored(int x, int y) const { return inBounds(x, y) && test(explored, x, y); }
+    const std::vector<Point>& getChangedCells() const { return changedCells; }
+
+private:
+    bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+    bool test(const std::vector<std::uint64_t>& bits, int x, int y) const {
+        std::size_t index = static_cast<std::size_t>(y) * width + x;
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+    void assign(std::vector<std::uint64_t>& bits, int x, int y, bool value);
+
+    void markVisible(int x, int y);
+    void castLight(const std::vector<std::vector<char>>& maze, const Point& origin, int radius, int row,
+                   float startSlope, float endSlope, int xx, int xy, int yx, int yy);
+
+    int width, height;
+    std::vector<std::uint64_t> visible;
+    std::vector<std::uint64_t> previouslyVisible;
+    std::vector<std::uint64_t> explored;
+    std::vector<Point> visibleCells;
+    std::vector<Point> previousCells;
+    std::vector<Point> changedCells;
+};
@@ -0,0 +1,59 @@
+// FramePacer.hpp
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Frame pacing for animated states. Replaces setFramerateLimit(), whose
+// plain sleep overshoots by up to a scheduler quantum, with deadline-based
+// waits that sleep most of the way and spin the last stretch.
+//
+//   UNCAPPED     no waiting at all
+//   CAPPED       work, then wait for the frame deadline
+//   LOW_LATENCY  wait first, starting the frame just early enough to finish
+//                by the deadline, so input is sampled as late as possible
+//   POWER_SAVER  half rate, sleep only
+class FramePacer {
+public:
+    enum class Policy {
+        UNCAPPED,
+        CAPPED,
+        LOW_LATENCY,
+        POWER_SAVER
+    };
+
+    struct FrameStats {
+        float averageMs;    // Smoothed frame-to-frame time
+        float jitterMs;     // Smoothed deviation from averageMs
+
+        FrameStats() : averageMs(0.0f), jitterMs(0.0f) {}
+    };
+
+    explicit FramePacer(Policy policy = Policy::CAPPED, unsigned targetFps = 60);
+
+    void apply(sf::RenderWindow& window) const;
+    void beginFrame();
+    void endFrame();
+    // Call after blocking elsewhere (e.g. waitEvent()) so the schedule does
+    // not try to catch up on the time spent idle.
+    void resync();
+
+    Policy getPolicy() const { return policy; }
+    const FrameStats& getStats() const { return stats; }
+
+    static bool parsePolicy(const std::string& name, Policy& policy);
+
+private:
+    sf::Int64 now() const { return clock.getElapsedTime().asMicroseconds(); }
+    void waitUntil(sf::Int64 deadline) const;
+    void advanceDeadline(sf::Int64 current);
+
+    Policy policy;
+    sf::Clock clock;
+    sf::Int64 frameInterval;
+    sf::Int64 spinThreshold;
+    sf::Int64 nextDeadline;
+    sf::Int64 frameStart;
+    sf::Int64 lastFrameEnd;
+    float workEstimate;     // Microseconds, smoothed
+    FrameStats stats;
+};
@@ -0,0 +1,88 @@
+// GameServer.hpp
+#pragma once
+#include <SFML/System.hpp>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <poll.h>
+#include <string>
+#include <vector>
+#include "GameSession.hpp"
+#include "NetProtocol.hpp"
+
+// Authoritative headless server. Each connected client owns one GameSession
+// that is stepped at a fixed tick rate; inputs received between ticks are
+// applied in order at the start of the next tick and every tick produces a
+// snapshot delta-encoded against the client's last acknowledged one.
+class GameServer {
+public:
+    struct Config {
+        int tickRate;
+        std::size_t maxClients;
+        std::size_t maxInputsPerTick;   // Per client, excess waits for later ticks
+        std::size_t maxQueuedInputs;    // Per client, oldest inputs are dropped past this
+        std::size_t maxPendingBytes;    // Per client, snapshots are skipped past this
+        std::size_t maxReadsPerPoll;    // Per client, 4 KB reads; the rest waits for the next pass
+        std::size_t snapshotHistory;
+
+        Config()
+            : tickRate(30), maxClients(512), maxInputsPerTick(8), maxQueuedInputs(64)
+            , maxPendingBytes(64 * 1024), maxReadsPerPoll(4), snapshotHistory(32) {}
+    };
+
+    explicit GameServer(const Config& config = Config());
+    ~GameServer();
+
+    // Local listeners only: Unix-domain socket path or TCP port on 127.0.0.1.
+    // Port 0 picks a free port; getTcpPort() returns the one bound.
+    bool listenUnix(const std::string& path);
+    bool listenTcp(unsigned short port);
+
+    void run();
+    void stop() { running = false; }
+    // One pass of run(): services sockets until the next tick is due, then
+    // ticks if it is. Returns false if polling failed.
+    bool poll();
+
+    std::size_t getClientCount() const { return clients.size(); }
+    std::uint32_t getTickCount() const { return tickCount; }
+    unsigned short getTcpPort() const { return tcpPort; }
+    // Clients are indexed in accept order.
+    const GameSession& getSession(std::size_t client) const { return clients[client]->session; }
+
+private:
+    struct Client {
+        int fd;
+        bool joined;
+        GameSession session;
+        std::vector<std::uint8_t> inbox;
+        std::vector<std::uint8_t> outbox;
+        std::size_t outboxOffset;
+        std::deque<GameSession::Action> pendingInputs;
+        std::uint32_t ackedId;
+        std::uint32_t nextSnapshotId;
+        std::deque<NetProtocol::Snapshot> history;
+
+        explicit Client(int fd);
+    };
+
+    bool openListener(int domain, const void* address, unsigned addressLength);
+    void acceptClients();
+    bool readClient(Client& client);
+    bool handleMessages(Client& client);
+    bool flushClient(Client& client);
+    void tick(float deltaTime);
+    void sendSnapshot(Client& client);
+    void closeClient(std::size_t index);
+
+    Config config;
+    std::vector<int> listeners;
+    std::vector<std::unique_ptr<Client>> clients;
+    std::string unixPath;
+    unsigned short tcpPort;
+    std::vector<pollfd> fds;
+    sf::Clock tickClock;
+    std::uint32_t tickCount;
+    std::atomic<bool> running;
+};
@@ -0,0 +1,98 @@
+// GameSession.hpp
+#pragma once
+#include <vector>
+#include <random>
+#include "Point.hpp"
+#include "Enemy.hpp"
+#include "PowerUp.hpp"
+#include "MemoryArena.hpp"
+
+// Headless simulation state for a single player: maze, enemies, power-ups
+// and stats. MazeGame drives one session from the window, GameServer hosts
+// many of them in one process.
+class GameSession {
+public:
+    enum class Difficulty {
+        EASY,
+        MEDIUM,
+        HARD
+    };
+
+    enum class Action : unsigned char {
+        NONE,
+        UP,
+        DOWN,
+        LEFT,
+        RIGHT,
+        RESTART
+    };
+
+    enum class StepResult {
+        NONE,
+        MOVED,
+        LEVEL_COMPLETE,
+        CAUGHT
+    };
+
+    struct GameStats {
+        int score;          // Current game score
+        int moveCount;      // Number of moves in current game
+        float timeElapsed;  // Time elapsed in current game
+        int highScore;      // All-time high score
+        int powerUpsCollected;
+
+        GameStats() : score(0), moveCount(0), timeElapsed(0.0f), highScore(0), powerUpsCollected(0) {}
+        
+        void resetForNewGame() {
+            score = 0;
+            moveCount = 0;
+            timeElapsed = 0.0f;
+            powerUpsCollected = 0;
+        }
+    };
+
+    explicit GameSession(Difficulty difficulty = Difficulty::MEDIUM,
+                         unsigned seed = std::random_device{}());
+
+    void startNewGame();
+    void generateMaze();
+    StepResult applyAction(Action action);
+    StepResult update(float deltaTime);
+    bool isValidMove(const Point& pos) const;
+
+    // Getters
+    const std::vector<std::vector<char>>& getMaze() const { return maze; }
+    const std::vector<Enemy>& getEnemies() const { return enemies; }
+    const std::vector<PowerUp>& getPowerUps() const { return powerUps; }
+    const Point& getPlayerPos() const { return playerPos; }
+    const Point& getEndPos() const { return endPos; }
+    Difficulty getDifficulty() const { return difficulty; }
+    GameStats& getStats() { return stats; }
+    const GameStats& getStats() const { return stats; }
+    unsigned getGridVersion() const { return gridVersion; }
+
+    // Setters
+    void setDifficulty(Difficulty newDifficulty) { difficulty = newDifficulty; }
+    void setSeed(unsigned seed) { rng.seed(seed); }
+
+private:
+    friend class RewindBuffer;
+    friend class VectorEnvironment;
+
+    void movePlayer(const Point& newPos);
+    void updateScore();
+    float difficultyMultiplier() const;
+    int randomInt(int bound);
+
+    std::vector<std::vector<char>> maze;
+    std::vector<Enemy> enemies;
+    std::vector<PowerUp> powerUps;
+
+    Difficulty difficulty;
+    GameStats stats;
+    Point playerPos;
+    Point endPos;
+    unsigned gridVersion;
+    std::mt19937 rng;
+    LinearArena scratch;    // Reset at the start of every generateMaze()
+};
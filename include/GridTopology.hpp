@@ -0,0 +1,264 @@
+// GridTopology.hpp
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MemoryArena.hpp"
+
+// Grid topologies as compile-time neighbour tables. Directions are ordered so
+// that the opposite of direction d is always d ^ 1. Topologies whose offsets
+// depend on the row (hex) provide one table per row parity.
+
+struct GridCoord {
+    int x, y, z;
+    constexpr GridCoord(int x = 0, int y = 0, int z = 0) : x(x), y(y), z(z) {}
+
+    bool operator==(const GridCoord& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+    bool operator!=(const GridCoord& other) const { return !(*this == other); }
+};
+
+struct GridOffset {
+    int dx, dy, dz;
+};
+
+// Four-connected square cells: up, down, left, right.
+struct SquareTopology {
+    static constexpr int DIRECTIONS = 4;
+    static constexpr int PARITIES = 1;
+    static constexpr GridOffset OFFSETS[PARITIES][DIRECTIONS] = {
+        {{0, -1, 0}, {0, 1, 0}, {-1, 0, 0}, {1, 0, 0}}
+    };
+    static constexpr int parity(int) { return 0; }
+};
+
+// Pointy-top hexagons in odd-r offset layout: east, west, north-east,
+// south-west, north-west, south-east. Odd rows are shifted half a cell right.
+struct HexTopology {
+    static constexpr int DIRECTIONS = 6;
+    static constexpr int PARITIES = 2;
+    static constexpr GridOffset OFFSETS[PARITIES][DIRECTIONS] = {
+        {{1, 0, 0}, {-1, 0, 0}, {0, -1, 0}, {-1, 1, 0}, {-1, -1, 0}, {0, 1, 0}},
+        {{1, 0, 0}, {-1, 0, 0}, {1, -1, 0}, {0, 1, 0}, {0, -1, 0}, {1, 1, 0}}
+    };
+    static constexpr int parity(int y) { return y & 1; }
+};
+
+// Square floors stacked on top of each other; the last two directions are
+// stairs up and down.
+struct StackedTopology {
+    static constexpr int DIRECTIONS = 6;
+    static constexpr int PARITIES = 1;
+    static constexpr GridOffset OFFSETS[PARITIES][DIRECTIONS] = {
+        {{0, -1, 0}, {0, 1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 0, 1}, {0, 0, -1}}
+    };
+    static constexpr int parity(int) { return 0; }
+};
+
+namespace GridTopologyDetail {
+    template<typename Visitor, int... Directions>
+    inline void unroll(Visitor&& visitor, std::integer_sequence<int, Directions...>) {
+        (visitor(std::integral_constant<int, Directions>()), ...);
+    }
+}
+
+// Calls visitor(std::integral_constant<int, d>) for every direction of the
+// topology. The loop is expanded at compile time so each call sees its
+// offset as a constant.
+template<typename Topology, typename Visitor>
+inline void forEachDirection(Visitor&& visitor) {
+    GridTopologyDetail::unroll(visitor, std::make_integer_sequence<int, Topology::DIRECTIONS>());
+}
+
+// Maze stored as one passage bitmask per cell (bit d set when the wall in
+// direction d is open), so every topology shares the same storage.
+template<typename Topology>
+class TopologyMaze {
+public:
+    static_assert(Topology::DIRECTIONS <= 8, "Passage masks are 8 bits wide");
+
+    TopologyMaze(int width, int height, int depth = 1)
+        : width(width), height(height), depth(depth)
+        , passages(static_cast<std::size_t>(width) * height * depth, 0) {}
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getDepth() const { return depth; }
+    std::size_t getCellCount() const { return passages.size(); }
+
+    bool contains(const GridCoord& cell) const {
+        return (static_cast<unsigned>(cell.x) < static_cast<unsigned>(width)) &
+               (static_cast<unsigned>(cell.y) < static_cast<unsigned>(height)) &
+               (static_cast<unsigned>(cell.z) < static_cast<unsigned>(depth));
+    }
+
+    std::size_t index(const GridCoord& cell) const {
+        return (static_cast<std::size_t>(cell.z) * height + cell.y) * width + cell.x;
+    }
+
+    GridCoord coord(std::size_t cellIndex) const {
+        int x = static_cast<int>(cellIndex % width);
+        int y = static_cast<int>(cellIndex / width % height);
+        int z = static_cast<int>(cellIndex / (static_cast<std::size_t>(width) * height));
+        return GridCoord(x, y, z);
+    }
+
+    template<int Direction>
+    static GridCoord neighbor(const GridCoord& cell) {
+        const GridOffset& offset = Topology::OFFSETS[Topology::parity(cell.y)][Direction];
+        return GridCoord(cell.x + offset.dx, cell.y + offset.dy, cell.z + offset.dz);
+    }
+
+    static GridCoord neighbor(const GridCoord& cell, int direction) {
+        const GridOffset& offset = Topology::OFFSETS[Topology::parity(cell.y)][direction];
+        return GridCoord(cell.x + offset.dx, cell.y + offset.dy, cell.z + offset.dz);
+    }
+
+    std::uint8_t getPassages(const GridCoord& cell) const { return passages[index(cell)]; }
+
+    // Counterpart of GameSession::isValidMove() for passage-based mazes.
+    bool isValidMove(const GridCoord& from, int direction) const {
+        return contains(from) && ((passages[index(from)] >> direction) & 1);
+    }
+
+    void carve(const GridCoord& cell, int direction) {
+        passages[index(cell)] |= static_cast<std::uint8_t>(1 << direction);
+        passages[index(neighbor(cell, direction))] |= static_cast<std::uint8_t>(1 << (direction ^ 1));
+    }
+
+    // Recursive backtracker producing a perfect maze over every cell.
+    void generate(std::mt19937& rng, LinearArena& scratch, const GridCoord& start = GridCoord()) {
+        generateRegion(rng, scratch, GridCoord(), GridCoord(width, height, depth), start);
+    }
+
+    // Recursive backtracker confined to the box [low, high). The box is
+    // cleared first and no wall leaving it is opened, so disjoint boxes can be
+    // generated concurrently as long as every box is regenerated together.
+    void generateRegion(std::mt19937& rng, LinearArena& scratch,
+                        const GridCoord& low, const GridCoord& high, const GridCoord& start) {
+        const int regionWidth = high.x - low.x;
+        const int regionHeight = high.y - low.y;
+        const std::size_t regionCells = static_cast<std::size_t>(regionWidth) * regionHeight * (high.z - low.z);
+        for (int z = low.z; z < high.z; ++z) {
+            for (int y = low.y; y < high.y; ++y) {
+                std::size_t row = index(GridCoord(low.x, y, z));
+                std::fill(passages.begin() + row, passages.begin() + row + regionWidth, 0);
+            }
+        }
+
+        auto inside = [&](const GridCoord& cell) {
+            return (static_cast<unsigned>(cell.x - low.x) < static_cast<unsigned>(regionWidth)) &
+                   (static_cast<unsigned>(cell.y - low.y) < static_cast<unsigned>(regionHeight)) &
+                   (static_cast<unsigned>(cell.z - low.z) < static_cast<unsigned>(high.z - low.z));
+        };
+        auto local = [&](const GridCoord& cell) {
+            return (static_cast<std::size_t>(cell.z - low.z) * regionHeight + (cell.y - low.y)) * regionWidth +
+                   (cell.x - low.x);
+        };
+
+        scratch.reset();
+        unsigned char* visited = scratch.allocate<unsigned char>(regionCells);
+        GridCoord* stack = scratch.allocate<GridCoord>(regionCells);
+        std::size_t stackSize = 0;
+
+        GridCoord current = start;
+        visited[local(current)] = 1;
+        stack[stackSize++] = current;
+
+        while (stackSize > 0) {
+            current = stack[stackSize - 1];
+
+            int choices[Topology::DIRECTIONS];
+            int choiceCount = 0;
+            forEachDirection<Topology>([&](auto direction) {
+                GridCoord next = neighbor<decltype(direction)::value>(current);
+                bool isInside = inside(next);
+                bool fresh = isInside && !visited[isInside ? local(next) : 0];
+                choices[choiceCount] = decltype(direction)::value;
+                choiceCount += fresh;
+            });
+
+            if (choiceCount == 0) {
+                stackSize--;
+                continue;
+            }
+
+            int direction = choices[rng() % static_cast<unsigned>(choiceCount)];
+            GridCoord next = neighbor(current, direction);
+            carve(current, direction);
+            visited[local(next)] = 1;
+            stack[stackSize++] = next;
+        }
+    }
+
+    // Opens count random extra walls, creating loops.
+    void addOpenings(int count, std::mt19937& rng) {
+        for (int i = 0; i < count; ++i) {
+            GridCoord cell = coord(rng() % passages.size());
+            int direction = static_cast<int>(rng() % Topology::DIRECTIONS);
+            if (contains(neighbor(cell, direction))) {
+                carve(cell, direction);
+            }
+        }
+    }
+
+    // Breadth-first search; returns the step count or -1 when unreachable.
+    int solve(const GridCoord& from, const GridCoord& to, LinearArena& scratch) const {
+        scratch.reset();
+        int* distance = scratch.allocate<int>(passages.size());
+        std::size_t* queue = scratch.allocate<std::size_t>(passages.size());
+        std::fill(distance, distance + passages.size(), -1);
+
+        std::size_t queueSize = 0;
+        distance[index(from)] = 0;
+        queue[queueSize++] = index(from);
+        const std::size_t target = index(to);
+
+        for (std::size_t head = 0; head < queueSize; ++head) {
+            std::size_t cellIndex = queue[head];
+            if (cellIndex == target) return distance[cellIndex];
+
+            GridCoord cell = coord(cellIndex);
+            std::uint8_t open = passages[cellIndex];
+            forEachDirection<Topology>([&](auto direction) {
+                constexpr int d = decltype(direction)::value;
+                if (!((open >> d) & 1)) return;
+                std::size_t next = index(neighbor<d>(cell));
+                if (distance[next] < 0) {
+                    distance[next] = distance[cellIndex] + 1;
+                    queue[queueSize++] = next;
+                }
+            });
+        }
+        return -1;
+    }
+
+private:
+    int width, height, depth;
+    std::vector<std::uint8_t> passages;
+};
+
+// Converts a square passage maze to the '#'/' ' cell grid GameSession uses,
+// where walls occupy cells of their own: cell (x, y) lands on (2x+1, 2y+1).
+inline std::vector<std::vector<char>> rasterize(const TopologyMaze<SquareTopology>& maze) {
+    std::vector<std::vector<char>> grid(maze.getHeight() * 2 + 1,
+                                        std::vector<char>(maze.getWidth() * 2 + 1, '#'));
+    for (int y = 0; y < maze.getHeight(); ++y) {
+        for (int x = 0; x < maze.getWidth(); ++x) {
+            std::uint8_t open = maze.getPassages(GridCoord(x, y));
+            grid[2 * y + 1][2 * x + 1] = ' ';
+            forEachDirection<SquareTopology>([&](auto direction) {
+                constexpr GridOffset offset = SquareTopology::OFFSETS[0][decltype(direction)::value];
+                if ((open >> decltype(direction)::value) & 1) {
+                    grid[2 * y + 1 + offset.dy][2 * x + 1 + offset.dx] = ' ';
+                }
+            });
+        }
+    }
+    return grid;
+}
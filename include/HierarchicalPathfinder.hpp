@@ -0,0 +1,96 @@
+// HierarchicalPathfinder.hpp
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Point.hpp"
+
+// HPA* over a '#'/' ' cell grid. The grid is cut into square clusters; every
+// maximal run of open cells crossing a cluster border becomes one entrance,
+// with a node on each side. Each cluster stores in-cluster shortest-path
+// edges between its own nodes (dropping any edge that merely passes through
+// a third node), which together with the one-step border crossings form the
+// abstract graph. Queries search that graph first and refine the
+// result cluster by cluster, and a changed cell only rebuilds the cluster it
+// lies in (plus the neighbour sharing the border, for border cells).
+class HierarchicalPathfinder {
+public:
+    static const int DEFAULT_CLUSTER_SIZE = 32;
+
+    explicit HierarchicalPathfinder(int clusterSize = DEFAULT_CLUSTER_SIZE);
+
+    // Copies the grid and builds every cluster across threadCount workers
+    // (0 picks the hardware concurrency).
+    void build(const std::vector<std::vector<char>>& maze, unsigned threadCount = 0);
+    void setCell(int x, int y, bool open);
+
+    // Shortest path length on the abstract graph, -1 if unreachable.
+    // waypoints receives from, every entrance cell the path passes, and to.
+    int findWaypoints(const Point& from, const Point& to, std::vector<Point>& waypoints);
+
+    // As findWaypoints, refined into every cell of the path.
+    int findPath(const Point& from, const Point& to, std::vector<Point>& path);
+
+    bool isOpen(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height && grid[static_cast<std::size_t>(y) * width + x];
+    }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getClusterSize() const { return clusterSize; }
+    int getNodeCount() const { return nodeBase.empty() ? 0 : nodeBase.back(); }
+
+private:
+    static constexpr std::uint16_t UNREACHABLE = 0xffff;
+
+    struct Edge {
+        std::uint16_t target;   // Node index within the same cluster
+        std::uint16_t cost;
+    };
+
+    struct Cluster {
+        int x0, y0, width, height;
+        // Nodes are grouped by side in SquareTopology direction order (up,
+        // down, left, right); side s owns [sideStart[s], sideStart[s + 1]).
+        std::array<int, 5> sideStart;
+        std::vector<Point> nodes;
+        std::vector<int> edgeStart;     // Edges of node i: [edgeStart[i], edgeStart[i + 1])
+        std::vector<Edge> edges;
+    };
+
+    // BFS scratch sized for one cluster.
+    struct LocalSearch {
+        std::vector<int> distance;
+        std::vector<int> queue;
+        std::vector<std::uint16_t> matrix;  // Node-to-node distances while building
+    };
+
+    void buildCluster(int index, LocalSearch& search);
+    void renumber();
+    void searchCluster(const Cluster& cluster, const Point& from, LocalSearch& search) const;
+    bool refineSegment(const Point& from, const Point& to, std::vector<Point>& path);
+    int clusterAt(int x, int y) const { return (y / clusterSize) * clustersX + x / clusterSize; }
+    int clusterOfNode(int node) const;
+    int heuristic(const Point& from, const Point& to) const;
+
+    int clusterSize;
+    int width, height;
+    int clustersX, clustersY;
+    std::vector<std::uint8_t> grid;     // 1 for open cells
+    std::vector<Cluster> clusters;
+    std::vector<int> nodeBase;          // Global id of each cluster's first node
+
+    // Query state, reused between calls. Entries are valid only when their
+    // stamp matches the current query.
+    std::vector<int> gScore;
+    std::vector<int> parent;
+    std::vector<std::uint32_t> visited;
+    std::uint32_t queryStamp;
+    // Min-heap on (f << 32) - g: lowest f first, deepest node on ties.
+    std::vector<std::pair<std::int64_t, int>> open;
+    LocalSearch startSearch;
+    LocalSearch goalSearch;
+    std::vector<int> startLinks;
+    std::vector<int> goalLinks;
+    std::vector<Point> segmentWaypoints;
+};
@@ -0,0 +1,74 @@
+// InputController.hpp
+#pragma once
+#include <SFML/Window.hpp>
+#include <SFML/System.hpp>
+#include <array>
+#include <cstddef>
+#include "GameSession.hpp"
+
+// Turns key events into timestamped movement commands. Presses are buffered
+// in arrival order and drained once per simulation tick; a held direction
+// repeats at a fixed rate measured against the tick clock instead of the
+// OS key-repeat. The delay between a key event and the move it caused is
+// tracked as input latency.
+class InputController {
+public:
+    struct Config {
+        float repeatDelay;      // Seconds a key must be held before repeating
+        float repeatInterval;   // Seconds between repeated moves
+        int maxRepeatsPerTick;  // Limits catch-up after a long tick
+
+        Config() : repeatDelay(0.18f), repeatInterval(0.07f), maxRepeatsPerTick(2) {}
+    };
+
+    struct Command {
+        GameSession::Action action;
+        sf::Int64 timestamp;    // Microseconds on the controller clock
+    };
+
+    struct LatencyStats {
+        float lastMs;
+        float averageMs;
+        float maxMs;
+        unsigned samples;
+
+        LatencyStats() : lastMs(0.0f), averageMs(0.0f), maxMs(0.0f), samples(0) {}
+    };
+
+    static const std::size_t BUFFER_SIZE = 32;
+
+    explicit InputController(const Config& config = Config());
+
+    static GameSession::Action actionForKey(sf::Keyboard::Key key);
+    sf::Int64 now() const { return clock.getElapsedTime().asMicroseconds(); }
+
+    void keyPressed(GameSession::Action action, sf::Int64 timestamp);
+    void keyReleased(GameSession::Action action, sf::Int64 timestamp);
+    void reset();
+
+    // Writes the moves due by now into out, buffered presses first and then
+    // repeats of the most recently pressed held key. Returns the count.
+    std::size_t collect(sf::Int64 now, Command* out, std::size_t capacity);
+    void recordApplied(const Command& command, sf::Int64 appliedAt);
+
+    const LatencyStats& getLatency() const { return latency; }
+    void resetLatency() { latency = LatencyStats(); }
+    void setConfig(const Config& newConfig) { config = newConfig; }
+
+private:
+    static const int DIRECTIONS = 4;
+    static int directionIndex(GameSession::Action action);
+
+    Config config;
+    sf::Clock clock;
+
+    std::array<Command, BUFFER_SIZE> buffer;
+    std::size_t bufferHead;
+    std::size_t bufferCount;
+
+    std::array<bool, DIRECTIONS> held;
+    int repeatDirection;        // -1 when no direction key is held
+    sf::Int64 nextRepeat;
+
+    LatencyStats latency;
+};
@@ -0,0 +1,108 @@
+// JunctionGraph.hpp
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Point.hpp"
+
+// The open cells of a '#'/' ' grid compressed into a weighted graph. Nodes sit
+// on dead ends, junctions and landmark cells (such as start and exit); every
+// run of two-neighbour cells between two nodes becomes one edge carrying its
+// length and cells. Searches expand nodes instead of cells, and changing a
+// cell only re-traces the corridors that touch it and its neighbours.
+class JunctionGraph {
+public:
+    struct Node {
+        Point position;
+        std::array<int, 4> edges;   // Edge leaving in each SquareTopology direction, -1 if none
+        bool live;
+    };
+
+    struct Edge {
+        int from, to;               // Node ids; equal for a corridor that loops back
+        int fromDirection;          // Direction the edge leaves each end in
+        int toDirection;
+        int length;                 // Steps between the two nodes
+        std::vector<Point> cells;   // Corridor cells in order from `from`, nodes excluded
+        bool live;
+    };
+
+    JunctionGraph();
+
+    // Copies the grid and traces every corridor. Landmarks become nodes even
+    // when they lie inside a corridor.
+    void build(const std::vector<std::vector<char>>& maze, const std::vector<Point>& landmarks = {});
+    void setCell(int x, int y, bool open);
+
+    // Shortest path length between two open cells, -1 if unreachable.
+    // Either end may lie inside a corridor.
+    int distance(const Point& from, const Point& to);
+    // As distance, with path receiving every cell from `from` to `to`.
+    int findPath(const Point& from, const Point& to, std::vector<Point>& path);
+
+    bool isOpen(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height && grid[static_cast<std::size_t>(y) * width + x];
+    }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // Slots of removed nodes and edges are reused; skip the ones not live.
+    const std::vector<Node>& getNodes() const { return nodes; }
+    const std::vector<Edge>& getEdges() const { return edges; }
+    int getNodeCount() const { return liveNodes; }
+    int getEdgeCount() const { return liveEdges; }
+    int getExpandedCount() const { return expanded; }   // Nodes expanded by the last query
+
+private:
+    // Where a query endpoint sits: on a node, or at index `offset` along an edge.
+    struct Anchor {
+        int node;
+        int edge;
+        int offset;     // Steps from the edge's `from` node
+    };
+
+    int search(const Point& from, const Point& to);
+    bool anchor(const Point& cell, Anchor& result) const;
+    bool isNodeCell(int x, int y) const;
+    void updateLinks(int x, int y);
+    int createNode(int x, int y);
+    void removeNode(int node);
+    void removeEdge(int edge);
+    void trace(int node, int direction);
+    void promoteRings(const std::vector<Point>& cells);
+    Point edgePoint(const Edge& edge, int offset) const;
+    void appendEdge(int edge, int fromOffset, int toOffset, std::vector<Point>& path) const;
+    std::size_t index(int x, int y) const { return static_cast<std::size_t>(y) * width + x; }
+    int heuristic(const Point& from, const Point& to) const;
+
+    int width, height;
+    std::vector<std::uint8_t> grid;         // 1 for open cells
+    std::vector<std::uint8_t> links;        // Bit per direction with an open neighbour
+    std::vector<std::uint8_t> landmark;
+    std::vector<int> nodeAt;                // Node on each cell, -1 if none
+    std::vector<int> edgeAt;                // Edge through each corridor cell, -1 if none
+    std::vector<int> offsetAt;              // Steps from that edge's `from` node
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::vector<int> freeNodes;
+    std::vector<int> freeEdges;
+    int liveNodes, liveEdges;
+
+    // Update scratch.
+    std::vector<int> frontier;
+    std::vector<Point> released;
+
+    // Query state, reused between calls. Entries are valid only when their
+    // stamp matches the current query.
+    std::vector<int> gScore;
+    std::vector<int> parentEdge;            // Edge the node was reached by, -1 for a source
+    std::vector<int> parentNode;
+    std::vector<std::uint32_t> visited;
+    std::uint32_t queryStamp;
+    // Min-heap on (f << 32) - g: lowest f first, deepest node on ties.
+    std::vector<std::pair<std::int64_t, int>> open;
+    Anchor start, goal;
+    int goalNode;                           // Node the best route leaves the graph at, -1 for a direct route
+    std::vector<int> chain;
+    int expanded;
+};
@@ -0,0 +1,56 @@
+// MazeAnalytics.hpp
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "GameSession.hpp"
+#include "JunctionGraph.hpp"
+#include "MemoryArena.hpp"
+
+// Structural measurements of generated mazes, used to sort them into
+// difficulty tiers that reflect how hard a maze plays rather than its size.
+namespace MazeAnalytics {
+    // Corridor length buckets: 1, 2, 3-4, 5-8, 9-16, 17-32, 33-64, 65+
+    const int CORRIDOR_BUCKETS = 8;
+    // Solution cells within this many steps of an enemy spawn count as exposed.
+    const int ENEMY_REACH = 4;
+
+    struct Metrics {
+        unsigned seed;
+        int openCells;
+        int solutionLength;         // Steps from start to exit, -1 if unreachable
+        int deadEnds;
+        int junctions;
+        float branchingFactor;      // Mean extra choices offered at a junction
+        std::array<int, CORRIDOR_BUCKETS> corridorLengths;
+        int exposedSolutionCells;   // Solution cells within ENEMY_REACH of an enemy
+        float difficultyScore;
+        int tier;
+
+        Metrics()
+            : seed(0), openCells(0), solutionLength(-1), deadEnds(0), junctions(0)
+            , branchingFactor(0.0f), corridorLengths(), exposedSolutionCells(0)
+            , difficultyScore(0.0f), tier(0) {}
+    };
+
+    // Search state reused between mazes; pass the same workspace for every
+    // maze to keep batches allocation-free.
+    struct Workspace {
+        LinearArena scratch;        // Reset at the start of every analyze()
+        JunctionGraph graph;
+        std::vector<Point> solution;
+    };
+
+    Metrics analyze(const GameSession& session, Workspace& workspace);
+    Metrics analyze(const GameSession& session);
+
+    // Generates and analyzes count mazes with seeds firstSeed, firstSeed + 1, ...
+    // across threadCount workers (0 picks the hardware concurrency).
+    std::vector<Metrics> analyzeBatch(GameSession::Difficulty difficulty, unsigned firstSeed,
+                                      std::size_t count, unsigned threadCount = 0);
+
+    // Picks tierCount - 1 score boundaries at equal quantiles of results and
+    // assigns every entry its tier. Returns the boundaries.
+    std::vector<float> calibrateTiers(std::vector<Metrics>& results, int tierCount);
+    int classify(float difficultyScore, const std::vector<float>& boundaries);
+}
@@ -0,0 +1,28 @@
+// MazeCanvas.hpp
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "MemoryArena.hpp"
+
+// Cached maze geometry: one texel per cell in a texture that is drawn as a
+// single scaled sprite, for both the main view and the minimap. setCell()
+// writes to a CPU copy and flush() uploads only the rectangle that changed.
+class MazeCanvas {
+public:
+    MazeCanvas();
+
+    bool resize(int width, int height);
+    void setCell(int x, int y, const sf::Color& color);
+    void flush(LinearArena& scratch);
+    void draw(sf::RenderWindow& window, float cellSize);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    int width, height;
+    std::vector<sf::Uint8> pixels;
+    sf::Texture texture;
+    sf::Sprite sprite;
+    int dirtyLeft, dirtyTop, dirtyRight, dirtyBottom;  // Inclusive; empty when left > right
+};
@@ -1,12 +1,32 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "Point.hpp"
-#include "Enemy.hpp"
-#include "PowerUp.hpp"
+#include "GameSession.hpp"
 #include "Button.hpp"
+#include "MemoryArena.hpp"
+#include "InputController.hpp"
+#include "FramePacer.hpp"
+#include "FieldOfView.hpp"
+#include "MazeCanvas.hpp"
+#include "Telemetry.hpp"
+#include "RewindBuffer.hpp"
+#include "AudioEngine.hpp"
+#include "JunctionGraph.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
 
+// The window, input events and drawing run on the calling thread; the game
+// session runs on a fixed-rate simulation thread. The render side sends
+// commands through a lock-free queue and draws the latest WorldSnapshot the
+// simulation published, so neither side waits for the other.
 class MazeGame {
 public:
     enum class GameState {
@@ -16,68 +36,161 @@ public:
         GAME_OVER
     };
 
-    enum class Difficulty {
-        EASY,
-        MEDIUM,
-        HARD
+    using Difficulty = GameSession::Difficulty;
+    using GameStats = GameSession::GameStats;
+
+    explicit MazeGame(FramePacer::Policy pacing = FramePacer::Policy::CAPPED,
+                      const std::string& telemetryPath = "");
+    ~MazeGame();
+    void run();
+
+private:
+    // Render thread -> simulation thread.
+    struct Command {
+        enum class Type : std::uint8_t {
+            START_GAME,     // difficulty, generation
+            RESTART,        // generation
+            PAUSE,
+            RESUME,
+            KEY_PRESSED,    // action, timestamp
+            KEY_RELEASED,   // action, timestamp
+            RESET_INPUT,
+            REWIND_START,
+            REWIND_STOP
+        };
+
+        Type type;
+        GameSession::Action action;
+        Difficulty difficulty;
+        std::uint32_t generation;
+        sf::Int64 timestamp;
     };
 
-    struct GameStats {
-        int score;          // Current game score
-        int moveCount;      // Number of moves in current game
-        float timeElapsed;  // Time elapsed in current game
-        int highScore;      // All-time high score
-        int powerUpsCollected;
-
-        GameStats() : score(0), moveCount(0), timeElapsed(0.0f), highScore(0), powerUpsCollected(0) {}
-        
-        void resetForNewGame() {
-            score = 0;
-            moveCount = 0;
-            timeElapsed = 0.0f;
-            powerUpsCollected = 0;
-        }
+    // Render thread -> simulation thread, one per rendered frame, since
+    // telemetry has a single producer.
+    struct FrameSample {
+        std::int32_t frameMicros;
+        std::int32_t jitterMicros;
     };
 
-    MazeGame();
-    void run();
+    // Everything the render thread draws, published once per tick. The maze
+    // is shared between snapshots until the grid version changes.
+    struct WorldSnapshot {
+        std::uint32_t generation;   // Game the snapshot belongs to
+        std::uint32_t tick;
+        unsigned gridVersion;
+        std::shared_ptr<const std::vector<std::vector<char>>> maze;
+        Point playerPos;
+        Point endPos;
+        std::vector<Point> enemies;
+        std::vector<PowerUp> powerUps;
+        GameStats stats;
+        InputController::LatencyStats latency;
+        bool gameOver;
 
-private:
+        WorldSnapshot() : generation(0), tick(0), gridVersion(0), gameOver(false) {}
+    };
+
+    // Render thread
     void initialize();
     void createButtons();
-    void handleDifficultySelection();
+    void waitForEvent();
+    void handleMenuEvent(const sf::Event& event);
     void handleInput();
+    void handleGameEvent(const sf::Event& event);
     void handleKeyPress(sf::Keyboard::Key key);
-    void update(float deltaTime);
+    void post(Command::Type type, GameSession::Action action = GameSession::Action::NONE);
+    void pushCommand(const Command& command);
+    void startGame(Difficulty difficulty);
+    bool hasWorld() const;
     void render();
     void drawGameOver();
     void drawDifficultyMenu();
     void drawMaze();
-    void generateMaze();
-    void updateScore();
+    void refreshMazeCanvas();
+    void refreshHintPath();
+    sf::Color cellColor(int x, int y) const;
+    void updateStatusText();
+    void showGameOver(const GameStats& stats);
+
+    // Simulation thread
+    void simulationLoop();
+    void waitForCommand();
+    bool processCommands();
+    void step(float deltaTime);
+    void applyQueuedMoves();
+    void publishWorld();
+    void recordFrameTelemetry();
+    void finishGame();
+    void startNewGame();
     void loadHighScore();
     void saveHighScore();
-    bool isValidMove(const Point& pos) const;
-    void movePlayer(const Point& newPos);
-    void handleGameOver();
-    void startNewGame();
 
     sf::RenderWindow window;
     sf::View gameView;
     sf::View minimapView;
     sf::Text statusText;
+    sf::Text titleText;
+    sf::Text gameOverText;
+    sf::RectangleShape cellShape;
     sf::Clock gameClock;
 
-    std::vector<std::vector<char>> maze;
+    // Scratch memory for a single frame, reset at the top of run()'s loop.
+    LinearArena frameArena;
+    std::string statusString;
+
+    // Fog of war and the cached maze texture. The canvas is rebuilt when the
+    // grid version changes and patched cell by cell as visibility changes.
+    FieldOfView fieldOfView;
+    MazeCanvas mazeCanvas;
+    unsigned canvasGridVersion;
+    Point visibilityOrigin;
+    bool canvasStale;
+
+    // Route from the player to the exit, shown while showSolution is on and
+    // recomputed only when the player moves or the grid changes. HPA* is for
+    // grids of HPA_MIN_CELLS and up, which no current difficulty produces.
+    JunctionGraph pathfinder;
+    HierarchicalPathfinder largePathfinder;
+    unsigned pathfinderGridVersion;
+    Point hintOrigin;
+    std::vector<Point> hintPath;
+
     std::vector<std::unique_ptr<Button>> buttons;
-    std::vector<Enemy> enemies;
-    std::vector<PowerUp> powerUps;
+    FramePacer pacer;
+    std::uint32_t gameGeneration;   // Bumped for every game the render side starts
+
+    // Shared between the threads; each side only uses its own end.
+    SpscQueue<Command, 256> commands;
+    SpscQueue<FrameSample, 256> frameSamples;
+    std::atomic<std::uint32_t> droppedFrameSamples;    // Frames rendered while frameSamples was full
+    TripleBuffer<WorldSnapshot> world;
+    std::atomic<bool> simulationRunning;
+    // While nothing is simulating, the simulation thread sleeps on
+    // simulationWake until pushCommand() or shutdown wakes it.
+    std::atomic<bool> simulationIdle;
+    std::mutex simulationMutex;
+    std::condition_variable simulationWake;
+    Telemetry telemetry;    // Recorded from the simulation thread only
+    AudioEngine audio;      // Played from the simulation thread only
+
+    // Simulation thread state. Holding Backspace steps the session back one
+    // recorded tick per simulation tick.
+    GameSession session;
+    InputController input;
+    RewindBuffer rewindBuffer;
+    std::shared_ptr<const std::vector<std::vector<char>>> publishedMaze;
+    unsigned publishedGridVersion;
+    std::uint32_t simulationTick;
+    std::uint32_t activeGeneration;
+    bool simulating;
+    bool rewinding;
+    bool gameOver;
+    std::thread simulation;
 
     GameState state;
-    Difficulty difficulty;
-    GameStats stats;
-    Point playerPos;
-    Point endPos;
     float cellSize;
     bool showSolution;
+    bool showMetrics;
+    bool fogOfWar;
 };
\ No newline at end of file
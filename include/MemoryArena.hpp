@@ -0,0 +1,47 @@
+// MemoryArena.hpp
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for short-lived scratch data (one frame, one maze
+// generation or search). Memory is released all at once by reset(). If a
+// cycle runs out of space the extra blocks come from the heap and the next
+// reset() grows the main buffer to the high-water mark, so a steady
+// workload stops allocating after its first cycle.
+class LinearArena {
+public:
+    explicit LinearArena(std::size_t capacity = 0);
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // Returns count value-initialized objects. Only trivially destructible
+    // types are allowed since nothing is destroyed on reset().
+    template<typename T>
+    T* allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "LinearArena only holds trivially destructible types");
+        T* items = static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+        for (std::size_t i = 0; i < count; ++i) {
+            new (items + i) T();
+        }
+        return items;
+    }
+
+    void reset();
+
+    std::size_t getUsed() const { return used; }
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    void* allocateBytes(std::size_t size, std::size_t alignment);
+
+    std::unique_ptr<unsigned char[]> buffer;
+    std::size_t capacity;
+    std::size_t offset;
+    std::size_t used;       // Bytes handed out this cycle, including overflow
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;
+};
@@ -0,0 +1,92 @@
+// NetProtocol.hpp
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Point.hpp"
+#include "GameSession.hpp"
+
+// Wire format shared by GameServer and its clients. Every message is framed
+// as [u32 length][u8 type][payload], little-endian. Snapshots are encoded as
+// a delta against the last snapshot the client acknowledged (base id 0 means
+// a full snapshot).
+namespace NetProtocol {
+    const int CHUNK_SIZE = 16;
+    const std::size_t CHUNK_BYTES = CHUNK_SIZE * CHUNK_SIZE / 8;
+    const std::size_t MAX_MESSAGE_SIZE = 1 << 20;
+
+    enum class MessageType : std::uint8_t {
+        HELLO = 1,      // client -> server: u8 difficulty
+        INPUT = 2,      // client -> server: u8 count, count x u8 action
+        ACK = 3,        // client -> server: u32 snapshot id
+        SNAPSHOT = 4    // server -> client: delta-encoded snapshot
+    };
+
+    // One bit per cell, set for walls.
+    using Chunk = std::array<std::uint8_t, CHUNK_BYTES>;
+    using ChunkGrid = std::vector<Chunk>;
+
+    struct EnemyState {
+        std::int16_t x, y;
+        std::uint16_t speedCenti;   // speed * 100
+
+        bool operator==(const EnemyState& other) const {
+            return x == other.x && y == other.y && speedCenti == other.speedCenti;
+        }
+        bool operator!=(const EnemyState& other) const { return !(*this == other); }
+    };
+
+    struct StatsState {
+        std::int32_t score;
+        std::int32_t moveCount;
+        std::uint32_t timeElapsedMs;
+        std::int32_t highScore;
+        std::int32_t powerUpsCollected;
+    };
+
+    struct Snapshot {
+        std::uint32_t id = 0;
+        std::uint32_t tick = 0;
+        std::uint16_t width = 0;
+        std::uint16_t height = 0;
+        std::uint32_t gridVersion = 0;
+        // Shared between consecutive snapshots while the grid is unchanged.
+        std::shared_ptr<const ChunkGrid> chunks;
+        Point player;
+        Point end;
+        std::vector<EnemyState> enemies;
+        StatsState stats = {};
+
+        int chunksX() const { return (width + CHUNK_SIZE - 1) / CHUNK_SIZE; }
+        int chunksY() const { return (height + CHUNK_SIZE - 1) / CHUNK_SIZE; }
+        bool isWall(int x, int y) const;
+    };
+
+    // Server side. previous may be null; its chunk grid is reused when the
+    // session's grid version has not moved.
+    Snapshot capture(const GameSession& session, std::uint32_t id, std::uint32_t tick,
+                     const Snapshot* previous);
+    void writeSnapshot(const Snapshot& current, const Snapshot* base, std::vector<std::uint8_t>& out);
+
+    // Client side. base must be the snapshot named by the message's base id
+    // (null for full snapshots). Returns false on malformed input.
+    bool readSnapshot(const std::uint8_t* data, std::size_t size, const Snapshot* base, Snapshot& out);
+    bool peekBaseId(const std::uint8_t* data, std::size_t size, std::uint32_t& baseId);
+
+    void writeHello(GameSession::Difficulty difficulty, std::vector<std::uint8_t>& out);
+    void writeInput(const std::vector<GameSession::Action>& actions, std::vector<std::uint8_t>& out);
+    void writeAck(std::uint32_t snapshotId, std::vector<std::uint8_t>& out);
+
+    enum class FrameStatus {
+        INCOMPLETE,
+        READY,
+        MALFORMED
+    };
+
+    // Locates the next complete frame in buffer starting at offset; consumed
+    // is set to the frame's total size when READY.
+    FrameStatus nextFrame(const std::vector<std::uint8_t>& buffer, std::size_t offset, MessageType& type,
+                   const std::uint8_t*& payload, std::size_t& payloadSize, std::size_t& consumed);
+}
@@ -0,0 +1,95 @@
+// RewindBuffer.hpp
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GameSession.hpp"
+
+// Ring of per-tick GameSession states covering the last few seconds of play.
+// The grid is stored as a table of immutable chunks: consecutive ticks share
+// the same table while the grid is unchanged, and a new table reuses every
+// chunk whose contents did not change. Enemies and power-ups are stored once
+// per maze (when generateMaze() spawns them) plus small per-tick deltas, with
+// a full keyframe every KEYFRAME_INTERVAL ticks to bound replay cost.
+class RewindBuffer {
+public:
+    static constexpr int CHUNK_SIZE = 16;
+    static constexpr std::uint32_t KEYFRAME_INTERVAL = 32;
+
+    explicit RewindBuffer(std::size_t capacityTicks);
+
+    // Records the session state for the given tick. Ticks must increase.
+    void capture(const GameSession& session, std::uint32_t tick);
+
+    // Restores the state recorded at `tick` and drops every newer record.
+    // Only the grid chunks that differ from the live grid are copied back.
+    bool rewind(GameSession& session, std::uint32_t tick);
+
+    void clear();
+
+    bool canRewind() const { return count > 1 && newestTick() > oldestTick(); }
+    std::uint32_t oldestTick() const;
+    std::uint32_t newestTick() const;
+    std::size_t getCount() const { return count; }
+
+private:
+    using GridChunk = std::array<char, CHUNK_SIZE * CHUNK_SIZE>;
+
+    struct GridTable {
+        int width = 0;
+        int height = 0;
+        int chunksX = 0;
+        std::vector<std::shared_ptr<const GridChunk>> chunks;
+    };
+
+    // Entities as spawned by one generateMaze() call.
+    struct Epoch {
+        std::vector<Enemy> enemies;
+        std::vector<PowerUp> powerUps;
+    };
+
+    struct EnemyDelta {
+        std::uint16_t index;
+        float pathIndex;
+    };
+
+    struct PowerUpDelta {
+        std::uint16_t index;
+        bool active;
+        float duration;
+    };
+
+    struct TickRecord {
+        std::uint32_t tick = 0;
+        bool keyframe = false;
+        std::shared_ptr<const GridTable> grid;
+        std::shared_ptr<const Epoch> epoch;
+        GameSession::Difficulty difficulty = GameSession::Difficulty::MEDIUM;
+        GameSession::GameStats stats;
+        Point playerPos;
+        Point endPos;
+        std::vector<EnemyDelta> enemies;
+        std::vector<PowerUpDelta> powerUps;
+    };
+
+    std::shared_ptr<const GridTable> buildTable(const GameSession& session) const;
+    void restoreGrid(GameSession& session, const GridTable& target);
+    const TickRecord* findRecord(std::uint32_t tick, std::size_t& position) const;
+    TickRecord& at(std::size_t position) { return records[(head + position) % records.size()]; }
+    const TickRecord& at(std::size_t position) const { return records[(head + position) % records.size()]; }
+
+    std::vector<TickRecord> records;
+    std::size_t head;       // Oldest record
+    std::size_t count;
+
+    // State as of the newest record, used to build deltas and to skip
+    // unchanged chunks on rewind.
+    std::shared_ptr<const GridTable> liveGrid;
+    std::shared_ptr<const Epoch> liveEpoch;
+    unsigned liveGridVersion;
+    std::uint32_t lastKeyframeTick;
+    std::vector<float> lastEnemyIndices;
+    std::vector<PowerUpDelta> lastPowerUps;
+};
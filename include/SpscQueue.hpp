@@ -0,0 +1,57 @@
+// SpscQueue.hpp
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity lock-free ring buffer for exactly one producer thread and
+// one consumer thread. Neither side blocks or allocates: tryPush() fails
+// when the ring is full and tryPop() fails when it is empty.
+template<typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0), cachedTail(0), cachedHead(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side.
+    bool tryPush(const T& item) {
+        std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - cachedTail == Capacity) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (currentHead - cachedTail == Capacity) return false;
+        }
+        items[currentHead & (Capacity - 1)] = item;
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool tryPop(T& item) {
+        std::size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (currentTail == cachedHead) return false;
+        }
+        item = items[currentTail & (Capacity - 1)];
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool empty() const {
+        return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire);
+    }
+
+private:
+    // Producer and consumer indices live on separate cache lines so the two
+    // threads do not invalidate each other on every operation.
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+    alignas(64) std::size_t cachedTail;     // Producer's last view of tail
+    alignas(64) std::size_t cachedHead;     // Consumer's last view of head
+    std::array<T, Capacity> items;
+};
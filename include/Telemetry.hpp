@@ -0,0 +1,60 @@
+// Telemetry.hpp
+#pragma once
+#include <SFML/System.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <istream>
+#include <string>
+#include <thread>
+#include "SpscQueue.hpp"
+
+// Structured gameplay events. The game thread pushes fixed-size events into a
+// lock-free ring; a background thread encodes them into a compact binary log
+// (see decode() and tools/telemetry_decode.cpp). record() never blocks or
+// allocates: if the writer falls behind, events are dropped and counted.
+class Telemetry {
+public:
+    enum class EventType : std::uint8_t {
+        SESSION_START = 1,  // a = difficulty
+        MOVE = 2,           // a = x, b = y
+        DEATH = 3,          // a = score, b = level time (ms)
+        LEVEL_COMPLETE = 4, // a = score, b = moves, c = level time (ms)
+        POWERUP_PICKUP = 5, // a = power-up type, b = x, c = y
+        FRAME = 6,          // a = frame time (us), b = jitter (us), c = earlier frames not reported
+        DROPPED = 7         // a = events dropped since the last report
+    };
+
+    struct Event {
+        std::uint64_t timestamp;    // Microseconds since start()
+        EventType type;
+        std::int32_t a, b, c;
+    };
+
+    static const std::size_t QUEUE_SIZE = 4096;
+
+    Telemetry();
+    ~Telemetry();
+
+    bool start(const std::string& path);
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    // Game thread only.
+    void record(EventType type, std::int32_t a = 0, std::int32_t b = 0, std::int32_t c = 0);
+
+    // Reads a log produced by the writer, calling visitor for every event.
+    static bool decode(std::istream& in, const std::function<void(const Event&)>& visitor);
+    static const char* typeName(EventType type);
+
+private:
+    void writerLoop();
+
+    SpscQueue<Event, QUEUE_SIZE> queue;
+    std::atomic<bool> running;
+    std::atomic<std::uint32_t> dropped;
+    std::thread writer;
+    std::FILE* file;
+    sf::Clock clock;
+};
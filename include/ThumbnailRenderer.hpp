@@ -0,0 +1,42 @@
+// ThumbnailRenderer.hpp
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "GameSession.hpp"
+#include "JunctionGraph.hpp"
+
+// Windowless maze previews for curating level packs. Every cell becomes a
+// square block of pixels written straight into a CPU buffer, and PNGs are
+// encoded through sf::Image on the worker threads, so no window, display or
+// GPU context is involved.
+namespace ThumbnailRenderer {
+    struct Options {
+        int cellSize;           // Pixels per cell side
+        bool showSolution;      // Mark the route from start to exit
+        int sheetColumns;       // Contact sheet columns (one pixel per cell); 0 skips the sheet
+        unsigned threadCount;   // 0 picks the hardware concurrency
+
+        Options() : cellSize(4), showSolution(true), sheetColumns(0), threadCount(0) {}
+    };
+
+    // Per-thread state, reused between thumbnails.
+    struct Workspace {
+        std::vector<sf::Uint8> pixels;  // RGBA, row by row
+        JunctionGraph graph;
+        std::vector<Point> solution;
+        sf::Image image;
+    };
+
+    // Draws the session's maze, start, exit, enemies and (optionally) the
+    // solution into workspace.pixels and returns the image width in pixels.
+    int render(const GameSession& session, const Options& options, Workspace& workspace);
+
+    // Generates count mazes with seeds firstSeed, firstSeed + 1, ... and
+    // writes <directory>/maze_<seed>.png for each, plus
+    // <directory>/contact_sheet.png when options.sheetColumns > 0. The
+    // directory must exist. Returns the number of thumbnails written.
+    std::size_t renderBatch(GameSession::Difficulty difficulty, unsigned firstSeed, std::size_t count,
+                            const std::string& directory, const Options& options = Options());
+}
@@ -0,0 +1,22 @@
+// TiledMazeGenerator.hpp
+#pragma once
+#include "GridTopology.hpp"
+
+// Parallel generation of one large square maze. The grid is cut into tiles
+// that are carved independently on worker threads, then joined through one
+// random crossing per tile border chosen with union-find, so the result is
+// still a single perfect maze. Output depends only on the seed and tile size,
+// never on the thread count.
+namespace TiledMazeGenerator {
+    const int DEFAULT_TILE_SIZE = 256;
+
+    struct Options {
+        int tileSize;
+        unsigned threadCount;   // 0 picks the hardware concurrency
+        int extraOpenings;      // Random walls opened afterwards, creating loops
+
+        Options() : tileSize(DEFAULT_TILE_SIZE), threadCount(0), extraOpenings(0) {}
+    };
+
+    void generate(TopologyMaze<SquareTopology>& maze, unsigned seed, const Options& options = Options());
+}
@@ -0,0 +1,47 @@
+// TripleBuffer.hpp
+#pragma once
+#include <array>
+#include <atomic>
+
+// Lock-free "latest value" handoff from one writer thread to one reader
+// thread. The writer fills its back slot and publishes it by swapping it with
+// the shared middle slot; the reader swaps the middle slot for its front slot
+// only when something new was published. Neither side ever waits, and the
+// reader always sees the most recent complete value. Slots are reused, so the
+// writer must overwrite every field it publishes.
+template<typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : back(0), middle(1), front(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer side.
+    T& writeSlot() { return slots[back]; }
+
+    void publish() {
+        unsigned previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+
+    // Reader side. Returns true when a value newer than the current front
+    // slot was picked up.
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        unsigned previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& readSlot() const { return slots[front]; }
+
+private:
+    static const unsigned INDEX_MASK = 3;
+    static const unsigned FRESH = 4;
+
+    std::array<T, 3> slots;
+    alignas(64) unsigned back;                  // Writer only
+    alignas(64) std::atomic<unsigned> middle;   // Slot index, plus FRESH once published
+    alignas(64) unsigned front;                 // Reader only
+};
@@ -0,0 +1,119 @@
+// VectorEnvironment.hpp
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GameSession.hpp"
+
+// Many independent maze sessions stepped in lockstep for bot training. State
+// is kept as one array per field across all sessions, every step() applies
+// one action per session and fills the observation, reward and done arrays,
+// and sessions that finish are reset in place so the batch never shrinks.
+// Work is split into chunks of sessions across a persistent worker pool.
+//
+// Observation per session: the (2 * VIEW_RADIUS + 1)^2 cells around the
+// player row by row (0 open, 1 wall, 2 enemy, 3 exit), then four flags for
+// the exit lying right, left, below and above the player.
+class VectorEnvironment {
+public:
+    static constexpr int VIEW_RADIUS = 2;
+    static constexpr int VIEW_SIZE = 2 * VIEW_RADIUS + 1;
+    static constexpr std::size_t OBSERVATION_SIZE = VIEW_SIZE * VIEW_SIZE + 4;
+
+    enum Cell : std::uint8_t {
+        OPEN = 0,
+        WALL = 1,
+        ENEMY = 2,
+        EXIT = 3
+    };
+
+    struct Config {
+        GameSession::Difficulty difficulty;
+        float stepTime;         // Simulated seconds per step, for enemy movement
+        int maxSteps;           // Episodes are truncated after this many steps
+        float stepReward;
+        float exitReward;
+        float caughtReward;
+        unsigned seed;
+        unsigned threadCount;   // 0 picks the hardware concurrency
+
+        Config()
+            : difficulty(GameSession::Difficulty::MEDIUM), stepTime(0.1f), maxSteps(500)
+            , stepReward(-0.01f), exitReward(1.0f), caughtReward(-1.0f), seed(1), threadCount(0) {}
+    };
+
+    // Views into the environment's own buffers, valid until the next call.
+    struct Batch {
+        const std::uint8_t* observations;   // size() * OBSERVATION_SIZE
+        const float* rewards;
+        const std::uint8_t* dones;          // 1 when the episode ended this step
+    };
+
+    explicit VectorEnvironment(std::size_t count, const Config& config = Config());
+    ~VectorEnvironment();
+
+    Batch reset();
+    // actions holds one movement action per session.
+    Batch step(const GameSession::Action* actions);
+
+    std::size_t size() const { return count; }
+    std::uint64_t getEpisodesCompleted() const { return episodesCompleted.load(std::memory_order_relaxed); }
+
+private:
+    enum class Job {
+        RESET,
+        STEP
+    };
+
+    struct Worker {
+        explicit Worker(GameSession::Difficulty difficulty) : generator(difficulty) {}
+        GameSession generator;
+        std::thread thread;
+    };
+
+    Batch run(Job job, const GameSession::Action* actions);
+    void workerLoop(Worker& worker);
+    void runChunks(Worker& worker);
+    void resetSession(std::size_t index, Worker& worker);
+    void stepSession(std::size_t index, GameSession::Action action, Worker& worker);
+    void observe(std::size_t index);
+    Batch batch() const { return {observations.data(), rewards.data(), dones.data()}; }
+
+    const std::size_t count;
+    const Config config;
+    int width;
+    int height;
+    int enemiesPerSession;
+    float enemySpeedMultiplier;
+
+    // Per-session state, one array per field.
+    std::vector<std::uint8_t> walls;    // count * width * height, 1 for walls
+    std::vector<std::int16_t> playerX, playerY;
+    std::vector<std::int16_t> exitX, exitY;
+    std::vector<std::int32_t> steps;
+    std::vector<std::uint32_t> episodes;
+    std::vector<Enemy> enemies;         // count * enemiesPerSession
+
+    // Outputs.
+    std::vector<std::uint8_t> observations;
+    std::vector<float> rewards;
+    std::vector<std::uint8_t> dones;
+    std::atomic<std::uint64_t> episodesCompleted;
+
+    // Worker pool; worker 0 is the calling thread.
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::uint64_t jobId;
+    unsigned pending;
+    bool stopping;
+    Job job;
+    const GameSession::Action* jobActions;
+    std::atomic<std::size_t> nextChunk;
+};
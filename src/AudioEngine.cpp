@@ -0,0 +1,187 @@
+// AudioEngine.cpp
+#include "AudioEngine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    const unsigned SAMPLE_RATE = 44100;
+    const float PI = 3.14159265f;
+
+    struct CueInfo {
+        const char* name;       // sounds/<name>.wav overrides the synthesized tone
+        int priority;           // Higher priorities may steal lower ones
+        std::size_t maxVoices;  // Concurrent voices before the cue retriggers itself
+        float startHz;
+        float endHz;
+        float durationMs;
+    };
+
+    const CueInfo CUES[] = {
+        {"move",           0, 2,  440.0f,  520.0f,  40.0f},
+        {"collision",      2, 2,  220.0f,   80.0f, 350.0f},
+        {"pickup",         1, 3,  660.0f, 1320.0f, 150.0f},
+        {"level_complete", 3, 1,  523.0f, 1046.0f, 600.0f}
+    };
+
+    const CueInfo& info(AudioEngine::Cue cue) {
+        return CUES[static_cast<std::size_t>(cue)];
+    }
+
+    // Frequency sweep with a short attack and linear release, so cues work
+    // without any asset files.
+    void synthesize(sf::SoundBuffer& buffer, const CueInfo& cue) {
+        std::size_t count = static_cast<std::size_t>(SAMPLE_RATE * cue.durationMs / 1000.0f);
+        std::size_t attack = SAMPLE_RATE / 200;
+        std::vector<sf::Int16> samples(count);
+        float phase = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            float t = static_cast<float>(i) / count;
+            float frequency = cue.startHz + (cue.endHz - cue.startHz) * t;
+            phase += 2.0f * PI * frequency / SAMPLE_RATE;
+            float envelope = std::min(1.0f, static_cast<float>(i) / attack) * (1.0f - t);
+            samples[i] = static_cast<sf::Int16>(std::sin(phase) * envelope * 12000.0f);
+        }
+        buffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE);
+    }
+}
+
+AudioEngine::AudioEngine() : running(false), muted(false), dropped(0), sleeping(false), sequence(0) {
+    for (auto& voice : voices) {
+        voice.cue = Cue::MOVE;
+        voice.startedAt = 0;
+    }
+}
+
+AudioEngine::~AudioEngine() {
+    stop();
+}
+
+void AudioEngine::loadBuffers() {
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        const CueInfo& cue = CUES[i];
+        std::string path = std::string("sounds/") + cue.name + ".wav";
+        if (std::ifstream(path).good() && buffers[i].loadFromFile(path)) {
+            std::cout << "Loaded sound from: " << path << std::endl;
+            continue;
+        }
+        synthesize(buffers[i], cue);
+    }
+}
+
+bool AudioEngine::start() {
+    if (isRunning()) return true;
+
+    loadBuffers();
+    running.store(true, std::memory_order_release);
+    mixer = std::thread(&AudioEngine::mixerLoop, this);
+    return true;
+}
+
+void AudioEngine::stop() {
+    if (!isRunning()) return;
+
+    running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+    mixer.join();
+}
+
+bool AudioEngine::play(Cue cue, float volume, float pitch) {
+    if (!isRunning() || isMuted()) return false;
+
+    if (!requests.tryPush({cue, volume, pitch})) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Pairs with the fence in mixerLoop(): either the mixer sees this request
+    // when it rechecks the queue, or this sees it asleep and wakes it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.exchange(false)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+    return true;
+}
+
+void AudioEngine::assignVoice(const Request& request) {
+    const CueInfo& cue = info(request.cue);
+    Voice* target = nullptr;
+
+    // A cue past its own voice limit retriggers its oldest voice, so a burst
+    // of identical events never crowds out everything else.
+    std::size_t sameCue = 0;
+    Voice* oldestSame = nullptr;
+    Voice* freeVoice = nullptr;
+    Voice* victim = nullptr;
+    for (auto& voice : voices) {
+        if (voice.sound.getStatus() != sf::SoundSource::Playing) {
+            if (!freeVoice) freeVoice = &voice;
+            continue;
+        }
+        if (voice.cue == request.cue) {
+            sameCue++;
+            if (!oldestSame || voice.startedAt < oldestSame->startedAt) oldestSame = &voice;
+        }
+        int priority = info(voice.cue).priority;
+        if (priority <= cue.priority &&
+            (!victim || priority < info(victim->cue).priority ||
+             (priority == info(victim->cue).priority && voice.startedAt < victim->startedAt))) {
+            victim = &voice;
+        }
+    }
+
+    if (sameCue >= cue.maxVoices) {
+        target = oldestSame;
+    } else if (freeVoice) {
+        target = freeVoice;
+    } else {
+        target = victim;
+    }
+
+    if (!target) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    target->sound.stop();
+    target->sound.setBuffer(buffers[static_cast<std::size_t>(request.cue)]);
+    target->sound.setVolume(request.volume);
+    target->sound.setPitch(request.pitch);
+    target->sound.play();
+    target->cue = request.cue;
+    target->startedAt = ++sequence;
+}
+
+void AudioEngine::mixerLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        Request request;
+        while (requests.tryPop(request)) {
+            assignVoice(request);
+        }
+
+        // Announce the sleep before the last look at the queue, so a request
+        // pushed in between is either popped here or wakes the wait below.
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        sleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (requests.tryPop(request)) {
+            sleeping.store(false);
+            lock.unlock();
+            assignVoice(request);
+            continue;
+        }
+        wake.wait(lock, [this]() { return !sleeping.load() || !running.load(std::memory_order_acquire); });
+        sleeping.store(false);
+    }
+
+    for (auto& voice : voices) {
+        voice.sound.stop();
+    }
+}
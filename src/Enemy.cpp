@@ -7,6 +7,13 @@ Enemy::Enemy(Point startPos, float speed)
     generatePatrolPath();
 }
 
+void Enemy::reset(Point startPos, float newSpeed) {
+    position = startPos;
+    speed = newSpeed;
+    currentPathIndex = 0.0f;
+    generatePatrolPath();
+}
+
 void Enemy::update(float deltaTime) {
     if (patrolPath.size() < 2) return;
 
@@ -14,7 +21,17 @@ void Enemy::update(float deltaTime) {
     while (currentPathIndex >= patrolPath.size()) {
         currentPathIndex -= patrolPath.size();
     }
+    updatePosition();
+}
+
+void Enemy::setPathIndex(float pathIndex) {
+    currentPathIndex = pathIndex;
+    if (patrolPath.size() >= 2) {
+        updatePosition();
+    }
+}
 
+void Enemy::updatePosition() {
     int currentIndex = static_cast<int>(currentPathIndex);
     int nextIndex = (currentIndex + 1) % patrolPath.size();
     float fraction = currentPathIndex - currentIndex;
@@ -28,10 +45,20 @@ void Enemy::update(float deltaTime) {
 }
 
 void Enemy::draw(sf::RenderWindow& window, float cellSize) const {
-    sf::CircleShape shape(cellSize * 0.4f);
+    drawAt(window, position, cellSize);
+}
+
+void Enemy::drawAt(sf::RenderWindow& window, const Point& position, float cellSize) {
+    // Shared across enemies; setRadius() rebuilds the outline, so only call
+    // it when the cell size changes.
+    static sf::CircleShape shape;
+    const float radius = cellSize * 0.4f;
+    if (shape.getRadius() != radius) {
+        shape.setRadius(radius);
+        shape.setFillColor(sf::Color::Red);
+    }
     shape.setPosition(position.x * cellSize + cellSize * 0.1f,
                      position.y * cellSize + cellSize * 0.1f);
-    shape.setFillColor(sf::Color::Red);
     window.draw(shape);
 }
 
@@ -0,0 +1,109 @@
+// FieldOfView.cpp
+#include "FieldOfView.hpp"
+
+namespace {
+    // Transforms from octant-local (dx, dy) to grid offsets, one per octant.
+    const int OCTANTS[8][4] = {
+        {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+        {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}
+    };
+}
+
+FieldOfView::FieldOfView() : width(0), height(0) {}
+
+void FieldOfView::reset(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    std::size_t words = (static_cast<std::size_t>(width) * height + 63) / 64;
+    visible.assign(words, 0);
+    previouslyVisible.assign(words, 0);
+    explored.assign(words, 0);
+    visibleCells.clear();
+    previousCells.clear();
+    changedCells.clear();
+}
+
+void FieldOfView::assign(std::vector<std::uint64_t>& bits, int x, int y, bool value) {
+    std::size_t index = static_cast<std::size_t>(y) * width + x;
+    std::uint64_t mask = std::uint64_t(1) << (index & 63);
+    if (value) {
+        bits[index >> 6] |= mask;
+    } else {
+        bits[index >> 6] &= ~mask;
+    }
+}
+
+void FieldOfView::update(const std::vector<std::vector<char>>& maze, const Point& origin, int radius) {
+    // Move the current visible set aside, touching only the cells in it.
+    visibleCells.swap(previousCells);
+    visibleCells.clear();
+    changedCells.clear();
+    for (const Point& cell : previousCells) {
+        assign(visible, cell.x, cell.y, false);
+        assign(previouslyVisible, cell.x, cell.y, true);
+    }
+
+    if (inBounds(origin.x, origin.y)) {
+        markVisible(origin.x, origin.y);
+        for (const auto& octant : OCTANTS) {
+            castLight(maze, origin, radius, 1, 1.0f, 0.0f, octant[0], octant[1], octant[2], octant[3]);
+        }
+    }
+
+    for (const Point& cell : visibleCells) {
+        if (!test(previouslyVisible, cell.x, cell.y)) changedCells.push_back(cell);
+    }
+    for (const Point& cell : previousCells) {
+        if (!test(visible, cell.x, cell.y)) changedCells.push_back(cell);
+        assign(previouslyVisible, cell.x, cell.y, false);
+    }
+}
+
+void FieldOfView::markVisible(int x, int y) {
+    if (!inBounds(x, y) || test(visible, x, y)) return;
+    assign(visible, x, y, true);
+    assign(explored, x, y, true);
+    visibleCells.push_back(Point(x, y));
+}
+
+void FieldOfView::castLight(const std::vector<std::vector<char>>& maze, const Point& origin, int radius, int row,
+                            float startSlope, float endSlope, int xx, int xy, int yx, int yy) {
+    if (startSlope < endSlope) return;
+
+    auto blocksLight = [&](int x, int y) {
+        return !inBounds(x, y) || maze[y][x] == '#';
+    };
+
+    const int radiusSquared = radius * radius;
+    float nextStart = startSlope;
+    for (int distance = row; distance <= radius; ++distance) {
+        bool blocked = false;
+        int dy = -distance;
+        for (int dx = -distance; dx <= 0; ++dx) {
+            float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (startSlope < rightSlope) continue;
+            if (endSlope > leftSlope) break;
+
+            int x = origin.x + dx * xx + dy * xy;
+            int y = origin.y + dx * yx + dy * yy;
+            if (dx * dx + dy * dy <= radiusSquared) {
+                markVisible(x, y);
+            }
+
+            if (blocked) {
+                if (blocksLight(x, y)) {
+                    nextStart = rightSlope;
+                } else {
+                    blocked = false;
+                    startSlope = nextStart;
+                }
+            } else if (blocksLight(x, y) && distance < radius) {
+                blocked = true;
+                castLight(maze, origin, radius, distance + 1, startSlope, leftSlope, xx, xy, yx, yy);
+                nextStart = rightSlope;
+            }
+        }
+        if (blocked) break;
+    }
+}
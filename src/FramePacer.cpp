@@ -0,0 +1,86 @@
+// FramePacer.cpp
+#include "FramePacer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float SMOOTHING = 0.1f;
+    const sf::Int64 LOW_LATENCY_MARGIN = 500;  // Microseconds of slack before the deadline
+}
+
+FramePacer::FramePacer(Policy policy, unsigned targetFps)
+    : policy(policy)
+    , frameInterval(1000000 / std::max(1u, policy == Policy::POWER_SAVER ? targetFps / 2 : targetFps))
+    , spinThreshold(policy == Policy::POWER_SAVER ? 0 : 1500)
+    , nextDeadline(0)
+    , frameStart(0)
+    , lastFrameEnd(0)
+    , workEstimate(0.0f) {
+    resync();
+}
+
+bool FramePacer::parsePolicy(const std::string& name, Policy& policy) {
+    if (name == "uncapped") policy = Policy::UNCAPPED;
+    else if (name == "capped") policy = Policy::CAPPED;
+    else if (name == "low-latency") policy = Policy::LOW_LATENCY;
+    else if (name == "power-saver") policy = Policy::POWER_SAVER;
+    else return false;
+    return true;
+}
+
+void FramePacer::apply(sf::RenderWindow& window) const {
+    window.setFramerateLimit(0);
+    window.setVerticalSyncEnabled(false);
+}
+
+void FramePacer::beginFrame() {
+    if (policy == Policy::LOW_LATENCY) {
+        sf::Int64 lead = static_cast<sf::Int64>(workEstimate) + LOW_LATENCY_MARGIN;
+        waitUntil(nextDeadline - lead);
+    }
+    frameStart = now();
+}
+
+void FramePacer::endFrame() {
+    sf::Int64 current = now();
+    float work = static_cast<float>(current - frameStart);
+    workEstimate += (work - workEstimate) * SMOOTHING;
+
+    if (policy == Policy::CAPPED || policy == Policy::POWER_SAVER) {
+        waitUntil(nextDeadline);
+        current = now();
+    }
+    advanceDeadline(current);
+
+    float frameMs = static_cast<float>(current - lastFrameEnd) / 1000.0f;
+    lastFrameEnd = current;
+    stats.averageMs += (frameMs - stats.averageMs) * SMOOTHING;
+    stats.jitterMs += (std::fabs(frameMs - stats.averageMs) - stats.jitterMs) * SMOOTHING;
+}
+
+void FramePacer::resync() {
+    sf::Int64 current = now();
+    nextDeadline = current + frameInterval;
+    lastFrameEnd = current;
+}
+
+void FramePacer::waitUntil(sf::Int64 deadline) const {
+    if (policy == Policy::UNCAPPED) return;
+
+    sf::Int64 remaining = deadline - now();
+    if (remaining > spinThreshold) {
+        sf::sleep(sf::microseconds(remaining - spinThreshold));
+    }
+    while (now() < deadline) {
+        // Spin out the final stretch; sleeping here would overshoot.
+    }
+}
+
+void FramePacer::advanceDeadline(sf::Int64 current) {
+    nextDeadline += frameInterval;
+    // A frame that ran a whole interval late restarts the schedule instead
+    // of rushing the following frames to catch up.
+    if (nextDeadline < current) {
+        nextDeadline = current + frameInterval;
+    }
+}
@@ -0,0 +1,311 @@
+// GameServer.cpp
+#include "GameServer.hpp"
+#include <algorithm>
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace {
+    bool setNonBlocking(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+}
+
+GameServer::Client::Client(int fd)
+    : fd(fd)
+    , joined(false)
+    , outboxOffset(0)
+    , ackedId(0)
+    , nextSnapshotId(1) {}
+
+GameServer::GameServer(const Config& config)
+    : config(config)
+    , tcpPort(0)
+    , tickCount(0)
+    , running(false) {}
+
+GameServer::~GameServer() {
+    for (auto& client : clients) {
+        close(client->fd);
+    }
+    for (int fd : listeners) {
+        close(fd);
+    }
+    if (!unixPath.empty()) {
+        unlink(unixPath.c_str());
+    }
+}
+
+bool GameServer::listenUnix(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+    unlink(path.c_str());
+
+    if (!openListener(AF_UNIX, &address, sizeof(address))) {
+        return false;
+    }
+    unixPath = path;
+    std::cout << "Listening on unix:" << path << std::endl;
+    return true;
+}
+
+bool GameServer::listenTcp(unsigned short port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (!openListener(AF_INET, &address, sizeof(address))) {
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listeners.back(), reinterpret_cast<sockaddr*>(&address), &length);
+    tcpPort = ntohs(address.sin_port);
+    std::cout << "Listening on 127.0.0.1:" << tcpPort << std::endl;
+    return true;
+}
+
+bool GameServer::openListener(int domain, const void* address, unsigned addressLength) {
+    int fd = socket(domain, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "socket() failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (bind(fd, static_cast<const sockaddr*>(address), addressLength) != 0 ||
+        listen(fd, 64) != 0 || !setNonBlocking(fd)) {
+        std::cerr << "Could not listen: " << std::strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+
+    listeners.push_back(fd);
+    return true;
+}
+
+void GameServer::run() {
+    if (listeners.empty()) {
+        std::cerr << "GameServer::run() called without a listener" << std::endl;
+        return;
+    }
+
+    running = true;
+    tickClock.restart();
+    while (running && poll()) {}
+}
+
+bool GameServer::poll() {
+    const sf::Time tickTime = sf::seconds(1.0f / config.tickRate);
+
+    fds.clear();
+    for (int fd : listeners) {
+        fds.push_back({fd, POLLIN, 0});
+    }
+    for (const auto& client : clients) {
+        short events = POLLIN;
+        if (client->outboxOffset < client->outbox.size()) events |= POLLOUT;
+        fds.push_back({client->fd, events, 0});
+    }
+
+    sf::Time remaining = tickTime - tickClock.getElapsedTime();
+    int timeoutMs = std::max(0, static_cast<int>(remaining.asMilliseconds()));
+    if (::poll(fds.data(), fds.size(), timeoutMs) < 0 && errno != EINTR) {
+        std::cerr << "poll() failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Walk clients backwards so closing one does not shift unvisited entries.
+    for (std::size_t i = clients.size(); i-- > 0;) {
+        const pollfd& pfd = fds[listeners.size() + i];
+        bool alive = !(pfd.revents & (POLLERR | POLLNVAL));
+        if (alive && (pfd.revents & (POLLIN | POLLHUP))) alive = readClient(*clients[i]);
+        if (alive && (pfd.revents & POLLOUT)) alive = flushClient(*clients[i]);
+        if (!alive) closeClient(i);
+    }
+
+    for (std::size_t i = 0; i < listeners.size(); ++i) {
+        if (fds[i].revents & POLLIN) acceptClients();
+    }
+
+    if (tickClock.getElapsedTime() >= tickTime) {
+        tick(tickClock.restart().asSeconds());
+    }
+    return true;
+}
+
+void GameServer::acceptClients() {
+    for (int listener : listeners) {
+        while (true) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd < 0) break;
+
+            if (clients.size() >= config.maxClients || !setNonBlocking(fd)) {
+                close(fd);
+                continue;
+            }
+            clients.push_back(std::make_unique<Client>(fd));
+        }
+    }
+}
+
+bool GameServer::readClient(Client& client) {
+    // Bounded per pass so one flooding client cannot starve the others or
+    // the tick; poll() is level-triggered and reports the rest next pass.
+    std::uint8_t buffer[4096];
+    for (std::size_t reads = 0; reads < config.maxReadsPerPoll;) {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            client.inbox.insert(client.inbox.end(), buffer, buffer + received);
+            ++reads;
+            continue;
+        }
+        if (received == 0) return false;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        if (errno != EINTR) return false;
+    }
+    return handleMessages(client);
+}
+
+bool GameServer::handleMessages(Client& client) {
+    std::size_t offset = 0;
+    while (true) {
+        NetProtocol::MessageType type;
+        const std::uint8_t* payload;
+        std::size_t payloadSize, consumed;
+        auto status = NetProtocol::nextFrame(client.inbox, offset, type, payload, payloadSize, consumed);
+        if (status == NetProtocol::FrameStatus::MALFORMED) return false;
+        if (status == NetProtocol::FrameStatus::INCOMPLETE) break;
+        offset += consumed;
+
+        switch (type) {
+            case NetProtocol::MessageType::HELLO:
+                if (payloadSize < 1 || payload[0] > static_cast<std::uint8_t>(GameSession::Difficulty::HARD)) {
+                    return false;
+                }
+                client.session.setDifficulty(static_cast<GameSession::Difficulty>(payload[0]));
+                client.session.startNewGame();
+                client.joined = true;
+                client.history.clear();
+                client.ackedId = 0;
+                break;
+
+            case NetProtocol::MessageType::INPUT:
+                if (payloadSize < 1 || payloadSize < 1u + payload[0]) return false;
+                for (std::uint8_t i = 0; i < payload[0]; ++i) {
+                    if (payload[1 + i] > static_cast<std::uint8_t>(GameSession::Action::RESTART)) return false;
+                    client.pendingInputs.push_back(static_cast<GameSession::Action>(payload[1 + i]));
+                }
+                while (client.pendingInputs.size() > config.maxQueuedInputs) {
+                    client.pendingInputs.pop_front();
+                }
+                break;
+
+            case NetProtocol::MessageType::ACK:
+                if (payloadSize < 4) return false;
+                client.ackedId = static_cast<std::uint32_t>(payload[0]) |
+                                 static_cast<std::uint32_t>(payload[1]) << 8 |
+                                 static_cast<std::uint32_t>(payload[2]) << 16 |
+                                 static_cast<std::uint32_t>(payload[3]) << 24;
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    client.inbox.erase(client.inbox.begin(), client.inbox.begin() + offset);
+    return true;
+}
+
+bool GameServer::flushClient(Client& client) {
+    while (client.outboxOffset < client.outbox.size()) {
+        ssize_t sent = send(client.fd, client.outbox.data() + client.outboxOffset,
+                            client.outbox.size() - client.outboxOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            client.outboxOffset += sent;
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (sent < 0 && errno == EINTR) continue;
+        return false;
+    }
+
+    if (client.outboxOffset == client.outbox.size()) {
+        client.outbox.clear();
+        client.outboxOffset = 0;
+    }
+    return true;
+}
+
+void GameServer::tick(float deltaTime) {
+    tickCount++;
+
+    for (std::size_t i = clients.size(); i-- > 0;) {
+        Client& client = *clients[i];
+        if (!client.joined) continue;
+
+        GameSession& session = client.session;
+        for (std::size_t n = 0; n < config.maxInputsPerTick && !client.pendingInputs.empty(); ++n) {
+            session.applyAction(client.pendingInputs.front());
+            client.pendingInputs.pop_front();
+        }
+
+        if (session.update(deltaTime) == GameSession::StepResult::CAUGHT) {
+            GameSession::GameStats& stats = session.getStats();
+            stats.highScore = std::max(stats.highScore, stats.score);
+            session.startNewGame();
+        }
+
+        sendSnapshot(client);
+        if (!flushClient(client)) closeClient(i);
+    }
+}
+
+void GameServer::sendSnapshot(Client& client) {
+    // A slow reader falls behind instead of growing its buffer; the next
+    // snapshot it does get is a delta against whatever it acknowledged last.
+    if (client.outbox.size() - client.outboxOffset > config.maxPendingBytes) {
+        return;
+    }
+
+    const NetProtocol::Snapshot* previous = client.history.empty() ? nullptr : &client.history.back();
+    const NetProtocol::Snapshot* base = nullptr;
+    for (const auto& snapshot : client.history) {
+        if (snapshot.id == client.ackedId) {
+            base = &snapshot;
+            break;
+        }
+    }
+
+    NetProtocol::Snapshot current = NetProtocol::capture(client.session, client.nextSnapshotId++, tickCount, previous);
+    NetProtocol::writeSnapshot(current, base, client.outbox);
+
+    // Drop the oldest history, except the client's acked base: a client that
+    // stops acking keeps getting deltas against it rather than full snapshots.
+    client.history.push_back(std::move(current));
+    while (client.history.size() > config.snapshotHistory) {
+        auto oldest = client.history.begin();
+        if (oldest->id == client.ackedId) ++oldest;
+        client.history.erase(oldest);
+    }
+}
+
+void GameServer::closeClient(std::size_t index) {
+    close(clients[index]->fd);
+    clients.erase(clients.begin() + index);
+}
@@ -0,0 +1,221 @@
+// GameSession.cpp
+#include "GameSession.hpp"
+#include "GridTopology.hpp"
+
+GameSession::GameSession(Difficulty difficulty, unsigned seed)
+    : difficulty(difficulty)
+    , stats()
+    , gridVersion(0)
+    , rng(seed) {}
+
+void GameSession::startNewGame() {
+    stats.resetForNewGame();
+    generateMaze();
+}
+
+GameSession::StepResult GameSession::applyAction(Action action) {
+    if (action == Action::RESTART) {
+        startNewGame();
+        return StepResult::NONE;
+    }
+    if (action < Action::UP || action > Action::RIGHT) {
+        return StepResult::NONE;
+    }
+
+    // Movement actions follow SquareTopology's direction order.
+    const GridOffset& offset = SquareTopology::OFFSETS[0][static_cast<int>(action) - static_cast<int>(Action::UP)];
+    Point newPos(playerPos.x + offset.dx, playerPos.y + offset.dy);
+
+    if (!isValidMove(newPos)) {
+        return StepResult::NONE;
+    }
+
+    movePlayer(newPos);
+    if (newPos == endPos) {
+        updateScore();
+        generateMaze();
+        stats.moveCount = 0;
+        stats.timeElapsed = 0.0f;
+        return StepResult::LEVEL_COMPLETE;
+    }
+    return StepResult::MOVED;
+}
+
+GameSession::StepResult GameSession::update(float deltaTime) {
+    stats.timeElapsed += deltaTime;
+
+    float speedMultiplier = difficultyMultiplier();
+    for (auto& enemy : enemies) {
+        enemy.update(deltaTime * speedMultiplier);
+        if (enemy.checkCollision(playerPos)) {
+            return StepResult::CAUGHT;
+        }
+    }
+
+    for (auto& powerup : powerUps) {
+        powerup.update(deltaTime);
+    }
+    return StepResult::NONE;
+}
+
+void GameSession::generateMaze() {
+    int width, height;
+    switch (difficulty) {
+        case Difficulty::EASY:
+            width = height = 15;
+            break;
+        case Difficulty::MEDIUM:
+            width = height = 21;
+            break;
+        case Difficulty::HARD:
+        default:
+            width = height = 31;
+            break;
+    }
+    
+    // Rows are refilled in place so regenerating at the same size reuses
+    // their storage.
+    maze.resize(height);
+    for (auto& row : maze) {
+        row.assign(width, '#');
+    }
+    gridVersion++;
+    
+    playerPos = Point(1, 1);
+    endPos = Point(width - 2, height - 2);
+    
+    scratch.reset();
+    unsigned char* visited = scratch.allocate<unsigned char>(static_cast<std::size_t>(width) * height);
+    Point* stack = scratch.allocate<Point>(static_cast<std::size_t>(width / 2 + 1) * (height / 2 + 1));
+    int stackSize = 0;
+    Point current = playerPos;
+    
+    while (current != endPos) {
+        visited[current.y * width + current.x] = 1;
+        maze[current.y][current.x] = ' ';
+        
+        // Carving steps two cells at a time so walls keep a cell of their own.
+        Point neighbors[SquareTopology::DIRECTIONS];
+        int neighborCount = 0;
+        forEachDirection<SquareTopology>([&](auto direction) {
+            constexpr GridOffset offset = SquareTopology::OFFSETS[0][decltype(direction)::value];
+            Point next(current.x + 2 * offset.dx, current.y + 2 * offset.dy);
+            bool inside = (next.x > 0) & (next.x < width - 1) & (next.y > 0) & (next.y < height - 1);
+            neighbors[neighborCount] = next;
+            neighborCount += inside && !visited[inside ? next.y * width + next.x : 0];
+        });
+        
+        if (neighborCount > 0) {
+            Point next = neighbors[randomInt(neighborCount)];
+            maze[(current.y + next.y) / 2][(current.x + next.x) / 2] = ' ';
+            stack[stackSize++] = current;
+            current = next;
+        } else if (stackSize > 0) {
+            current = stack[--stackSize];
+        } else {
+            break;
+        }
+    }
+    
+    maze[playerPos.y][playerPos.x] = ' ';
+    maze[endPos.y][endPos.x] = ' ';
+    
+    int pathCount;
+    switch (difficulty) {
+        case Difficulty::EASY:
+            pathCount = width * height / 8;  // More paths = easier
+            break;
+        case Difficulty::MEDIUM:
+            pathCount = width * height / 10;
+            break;
+        case Difficulty::HARD:
+        default:
+            pathCount = width * height / 15; // Fewer paths = harder
+            break;
+    }
+    
+    for (int i = 0; i < pathCount; i++) {
+        int x = 1 + randomInt(width - 2);
+        int y = 1 + randomInt(height - 2);
+        if (Point(x, y) != playerPos && Point(x, y) != endPos) {
+            maze[y][x] = ' ';
+        }
+    }
+
+    int enemyCount;
+    float enemySpeed;
+    switch (difficulty) {
+        case Difficulty::EASY:
+            enemyCount = 2;
+            enemySpeed = 1.0f;
+            break;
+        case Difficulty::MEDIUM:
+            enemyCount = 4;
+            enemySpeed = 1.5f;
+            break;
+        case Difficulty::HARD:
+        default:
+            enemyCount = 6;
+            enemySpeed = 2.0f;
+            break;
+    }
+
+    for (int i = 0; i < enemyCount; i++) {
+        Point pos;
+        do {
+            pos.x = 1 + randomInt(width - 2);
+            pos.y = 1 + randomInt(height - 2);
+        } while (pos == playerPos || pos == endPos || maze[pos.y][pos.x] != ' ');
+
+        // Existing enemies are reset in place so their patrol paths keep
+        // their storage across regenerations.
+        if (i < static_cast<int>(enemies.size())) {
+            enemies[i].reset(pos, enemySpeed);
+        } else {
+            enemies.emplace_back(pos, enemySpeed);
+        }
+    }
+    enemies.erase(enemies.begin() + enemyCount, enemies.end());
+}
+
+void GameSession::updateScore() {
+    float multiplier = difficultyMultiplier();
+    
+    int mazeScore = static_cast<int>(1000 * multiplier);
+    mazeScore -= static_cast<int>(stats.timeElapsed * (10 * multiplier));
+    mazeScore -= static_cast<int>(stats.moveCount * (5 * multiplier));
+    
+    if (mazeScore < 0) mazeScore = 0;
+    stats.score += mazeScore;
+    
+    if (stats.score > stats.highScore) {
+        stats.highScore = stats.score;
+    }
+}
+
+float GameSession::difficultyMultiplier() const {
+    switch (difficulty) {
+        case Difficulty::EASY: return 1.0f;
+        case Difficulty::MEDIUM: return 1.5f;
+        case Difficulty::HARD: return 2.0f;
+    }
+    return 1.0f;
+}
+
+int GameSession::randomInt(int bound) {
+    return static_cast<int>(rng() % static_cast<unsigned>(bound));
+}
+
+bool GameSession::isValidMove(const Point& pos) const {
+    if (maze.empty() ||
+        pos.x < 0 || pos.x >= static_cast<int>(maze[0].size()) ||
+        pos.y < 0 || pos.y >= static_cast<int>(maze.size())) {
+        return false;
+    }
+    return maze[pos.y][pos.x] == ' ';
+}
+
+void GameSession::movePlayer(const Point& newPos) {
+    playerPos = newPos;
+    stats.moveCount++;
+}
@@ -0,0 +1,380 @@
+// HierarchicalPathfinder.cpp
+#include "HierarchicalPathfinder.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include "GridTopology.hpp"
+
+namespace {
+    const int INFINITE_COST = 0x3fffffff;
+
+    int localIndex(int x, int y, int x0, int y0, int stride) {
+        return (y - y0) * stride + (x - x0);
+    }
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(int clusterSize)
+    : clusterSize(std::max(4, clusterSize))
+    , width(0)
+    , height(0)
+    , clustersX(0)
+    , clustersY(0)
+    , queryStamp(0) {
+}
+
+void HierarchicalPathfinder::build(const std::vector<std::vector<char>>& maze, unsigned threadCount) {
+    height = static_cast<int>(maze.size());
+    width = maze.empty() ? 0 : static_cast<int>(maze[0].size());
+    grid.resize(static_cast<std::size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+        const char* row = maze[y].data();
+        std::uint8_t* out = &grid[static_cast<std::size_t>(y) * width];
+        for (int x = 0; x < width; ++x) {
+            out[x] = row[x] == ' ';
+        }
+    }
+
+    clustersX = (width + clusterSize - 1) / clusterSize;
+    clustersY = (height + clusterSize - 1) / clusterSize;
+    clusters.resize(static_cast<std::size_t>(clustersX) * clustersY);
+    for (int cy = 0; cy < clustersY; ++cy) {
+        for (int cx = 0; cx < clustersX; ++cx) {
+            Cluster& cluster = clusters[cy * clustersX + cx];
+            cluster.x0 = cx * clusterSize;
+            cluster.y0 = cy * clusterSize;
+            cluster.width = std::min(clusterSize, width - cluster.x0);
+            cluster.height = std::min(clusterSize, height - cluster.y0);
+        }
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Clusters only read the shared grid, so they build independently.
+    const std::size_t blockSize = 64;
+    std::atomic<std::size_t> nextBlock(0);
+    auto worker = [&]() {
+        LocalSearch search;
+        while (true) {
+            std::size_t begin = nextBlock.fetch_add(blockSize);
+            if (begin >= clusters.size()) break;
+            std::size_t end = std::min(clusters.size(), begin + blockSize);
+            for (std::size_t i = begin; i < end; ++i) {
+                buildCluster(static_cast<int>(i), search);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    renumber();
+}
+
+void HierarchicalPathfinder::setCell(int x, int y, bool open) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+    std::uint8_t& cell = grid[static_cast<std::size_t>(y) * width + x];
+    if (cell == static_cast<std::uint8_t>(open)) return;
+    cell = open;
+
+    // A border cell also changes the entrances the neighbouring cluster sees
+    // on that border; any other cell only changes in-cluster distances.
+    int index = clusterAt(x, y);
+    const Cluster& cluster = clusters[index];
+    LocalSearch search;
+    buildCluster(index, search);
+    if (x == cluster.x0 && x > 0) buildCluster(index - 1, search);
+    if (x == cluster.x0 + cluster.width - 1 && x < width - 1) buildCluster(index + 1, search);
+    if (y == cluster.y0 && y > 0) buildCluster(index - clustersX, search);
+    if (y == cluster.y0 + cluster.height - 1 && y < height - 1) buildCluster(index + clustersX, search);
+    renumber();
+}
+
+void HierarchicalPathfinder::buildCluster(int index, LocalSearch& search) {
+    Cluster& cluster = clusters[index];
+    cluster.nodes.clear();
+
+    for (int side = 0; side < SquareTopology::DIRECTIONS; ++side) {
+        const GridOffset& offset = SquareTopology::OFFSETS[0][side];
+        cluster.sideStart[side] = static_cast<int>(cluster.nodes.size());
+
+        // Walk the border cells on this side; the neighbouring cluster walks
+        // the same crossings in the same order, so run r on both sides forms
+        // one entrance.
+        bool horizontal = side < 2;
+        int length = horizontal ? cluster.width : cluster.height;
+        int fixed = side == 0 ? cluster.y0
+                  : side == 1 ? cluster.y0 + cluster.height - 1
+                  : side == 2 ? cluster.x0
+                  : cluster.x0 + cluster.width - 1;
+        int runStart = -1;
+        for (int i = 0; i <= length; ++i) {
+            bool crossing = false;
+            if (i < length) {
+                int x = horizontal ? cluster.x0 + i : fixed;
+                int y = horizontal ? fixed : cluster.y0 + i;
+                crossing = isOpen(x, y) && isOpen(x + offset.dx, y + offset.dy);
+            }
+            if (crossing && runStart < 0) {
+                runStart = i;
+            } else if (!crossing && runStart >= 0) {
+                int middle = (runStart + i - 1) / 2;
+                cluster.nodes.push_back(horizontal ? Point(cluster.x0 + middle, fixed)
+                                                   : Point(fixed, cluster.y0 + middle));
+                runStart = -1;
+            }
+        }
+    }
+    cluster.sideStart[SquareTopology::DIRECTIONS] = static_cast<int>(cluster.nodes.size());
+
+    std::size_t count = cluster.nodes.size();
+    std::vector<std::uint16_t>& matrix = search.matrix;
+    matrix.assign(count * count, UNREACHABLE);
+    for (std::size_t i = 0; i < count; ++i) {
+        searchCluster(cluster, cluster.nodes[i], search);
+        for (std::size_t j = i; j < count; ++j) {
+            const Point& node = cluster.nodes[j];
+            int distance = search.distance[localIndex(node.x, node.y, cluster.x0, cluster.y0, cluster.width)];
+            if (distance >= 0) {
+                matrix[i * count + j] = static_cast<std::uint16_t>(distance);
+                matrix[j * count + i] = static_cast<std::uint16_t>(distance);
+            }
+        }
+    }
+
+    // Keep i -> j only when no third node lies strictly inside a shortest
+    // path between them. Every dropped edge is covered by two strictly
+    // shorter ones, so shortest paths survive while corridor-like clusters
+    // keep a handful of edges instead of all pairs. (Corner cells can hold
+    // two nodes at distance zero; those never justify dropping an edge.)
+    cluster.edgeStart.assign(count + 1, 0);
+    cluster.edges.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        cluster.edgeStart[i] = static_cast<int>(cluster.edges.size());
+        for (std::size_t j = 0; j < count; ++j) {
+            std::uint16_t direct = matrix[i * count + j];
+            if (i == j || direct == UNREACHABLE) continue;
+            bool redundant = false;
+            for (std::size_t m = 0; m < count && !redundant; ++m) {
+                if (m == i || m == j || matrix[i * count + m] == 0 || matrix[m * count + j] == 0) continue;
+                int via = static_cast<int>(matrix[i * count + m]) + matrix[m * count + j];
+                redundant = via == direct;
+            }
+            if (!redundant) {
+                cluster.edges.push_back({static_cast<std::uint16_t>(j), direct});
+            }
+        }
+    }
+    cluster.edgeStart[count] = static_cast<int>(cluster.edges.size());
+}
+
+void HierarchicalPathfinder::renumber() {
+    nodeBase.resize(clusters.size() + 1);
+    nodeBase[0] = 0;
+    for (std::size_t i = 0; i < clusters.size(); ++i) {
+        nodeBase[i + 1] = nodeBase[i] + static_cast<int>(clusters[i].nodes.size());
+    }
+    std::size_t nodes = static_cast<std::size_t>(nodeBase.back());
+    gScore.resize(nodes);
+    parent.resize(nodes);
+    visited.resize(nodes, 0);
+}
+
+int HierarchicalPathfinder::clusterOfNode(int node) const {
+    // Empty clusters share their base with the next one, so take the last
+    // cluster whose base is not past the node.
+    return static_cast<int>(std::upper_bound(nodeBase.begin(), nodeBase.end(), node) - nodeBase.begin()) - 1;
+}
+
+int HierarchicalPathfinder::heuristic(const Point& from, const Point& to) const {
+    return std::abs(from.x - to.x) + std::abs(from.y - to.y);
+}
+
+void HierarchicalPathfinder::searchCluster(const Cluster& cluster, const Point& from, LocalSearch& search) const {
+    std::size_t cells = static_cast<std::size_t>(cluster.width) * cluster.height;
+    search.distance.assign(cells, -1);
+    search.queue.resize(cells);
+
+    std::size_t queueSize = 0;
+    int start = localIndex(from.x, from.y, cluster.x0, cluster.y0, cluster.width);
+    search.distance[start] = 0;
+    search.queue[queueSize++] = start;
+
+    for (std::size_t head = 0; head < queueSize; ++head) {
+        int current = search.queue[head];
+        int x = current % cluster.width;
+        int y = current / cluster.width;
+        forEachDirection<SquareTopology>([&](auto direction) {
+            constexpr GridOffset offset = SquareTopology::OFFSETS[0][decltype(direction)::value];
+            int nx = x + offset.dx;
+            int ny = y + offset.dy;
+            if (nx < 0 || ny < 0 || nx >= cluster.width || ny >= cluster.height) return;
+            int next = ny * cluster.width + nx;
+            if (search.distance[next] < 0 && isOpen(cluster.x0 + nx, cluster.y0 + ny)) {
+                search.distance[next] = search.distance[current] + 1;
+                search.queue[queueSize++] = next;
+            }
+        });
+    }
+}
+
+int HierarchicalPathfinder::findWaypoints(const Point& from, const Point& to, std::vector<Point>& waypoints) {
+    waypoints.clear();
+    if (!isOpen(from.x, from.y) || !isOpen(to.x, to.y)) return -1;
+    if (from == to) {
+        waypoints.push_back(from);
+        return 0;
+    }
+
+    // Connect the endpoints to the nodes of their own clusters.
+    int startCluster = clusterAt(from.x, from.y);
+    int goalCluster = clusterAt(to.x, to.y);
+    const Cluster& start = clusters[startCluster];
+    const Cluster& goal = clusters[goalCluster];
+    searchCluster(start, from, startSearch);
+    searchCluster(goal, to, goalSearch);
+    startLinks.resize(start.nodes.size());
+    for (std::size_t i = 0; i < start.nodes.size(); ++i) {
+        startLinks[i] = startSearch.distance[localIndex(start.nodes[i].x, start.nodes[i].y, start.x0, start.y0, start.width)];
+    }
+    goalLinks.resize(goal.nodes.size());
+    for (std::size_t i = 0; i < goal.nodes.size(); ++i) {
+        goalLinks[i] = goalSearch.distance[localIndex(goal.nodes[i].x, goal.nodes[i].y, goal.x0, goal.y0, goal.width)];
+    }
+
+    int best = INFINITE_COST;
+    int bestNode = -1;     // -1 with a finite best means the direct in-cluster path
+    if (startCluster == goalCluster) {
+        int direct = startSearch.distance[localIndex(to.x, to.y, start.x0, start.y0, start.width)];
+        if (direct >= 0) best = direct;
+    }
+
+    if (++queryStamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        queryStamp = 1;
+    }
+    open.clear();
+    auto key = [&](int cost, const Point& cell) {
+        return (static_cast<std::int64_t>(cost + heuristic(cell, to)) << 32) - cost;
+    };
+    auto relax = [&](int node, int cost, int from, const Point& cell) {
+        if (visited[node] == queryStamp && gScore[node] <= cost) return;
+        visited[node] = queryStamp;
+        gScore[node] = cost;
+        parent[node] = from;
+        open.emplace_back(key(cost, cell), node);
+        std::push_heap(open.begin(), open.end(), std::greater<std::pair<std::int64_t, int>>());
+    };
+
+    for (std::size_t i = 0; i < start.nodes.size(); ++i) {
+        if (startLinks[i] >= 0) {
+            relax(nodeBase[startCluster] + static_cast<int>(i), startLinks[i], -1, start.nodes[i]);
+        }
+    }
+
+    while (!open.empty()) {
+        std::pair<std::int64_t, int> top = open.front();
+        std::pop_heap(open.begin(), open.end(), std::greater<std::pair<std::int64_t, int>>());
+        open.pop_back();
+
+        int node = top.second;
+        int index = clusterOfNode(node);
+        const Cluster& cluster = clusters[index];
+        int local = node - nodeBase[index];
+        const Point& cell = cluster.nodes[local];
+        int cost = gScore[node];
+        if (top.first != key(cost, cell)) continue;  // Stale entry
+        if (cost + heuristic(cell, to) >= best) break;
+
+        if (index == goalCluster && goalLinks[local] >= 0 && cost + goalLinks[local] < best) {
+            best = cost + goalLinks[local];
+            bestNode = node;
+        }
+
+        // Cross the border into the matching node of the neighbouring cluster.
+        int side = 0;
+        while (local >= cluster.sideStart[side + 1]) side++;
+        const GridOffset& offset = SquareTopology::OFFSETS[0][side];
+        int neighborIndex = index + offset.dy * clustersX + offset.dx;
+        const Cluster& neighbor = clusters[neighborIndex];
+        int neighborLocal = neighbor.sideStart[side ^ 1] + (local - cluster.sideStart[side]);
+        // A node with no in-cluster edges can only lead back across the
+        // border, unless the goal is in its cluster.
+        bool deadEnd = neighbor.edgeStart[neighborLocal] == neighbor.edgeStart[neighborLocal + 1];
+        if (!deadEnd || neighborIndex == goalCluster) {
+            relax(nodeBase[neighborIndex] + neighborLocal, cost + 1, node, neighbor.nodes[neighborLocal]);
+        }
+
+        for (int e = cluster.edgeStart[local]; e < cluster.edgeStart[local + 1]; ++e) {
+            const Edge& edge = cluster.edges[e];
+            relax(nodeBase[index] + edge.target, cost + edge.cost, node, cluster.nodes[edge.target]);
+        }
+    }
+
+    if (best == INFINITE_COST) return -1;
+
+    waypoints.push_back(to);
+    for (int node = bestNode; node >= 0; node = parent[node]) {
+        int index = clusterOfNode(node);
+        const Point& cell = clusters[index].nodes[node - nodeBase[index]];
+        if (cell != waypoints.back()) waypoints.push_back(cell);
+    }
+    if (from != waypoints.back()) waypoints.push_back(from);
+    std::reverse(waypoints.begin(), waypoints.end());
+    return best;
+}
+
+bool HierarchicalPathfinder::refineSegment(const Point& from, const Point& to, std::vector<Point>& path) {
+    // Search outward from the target, then walk downhill from the source.
+    const Cluster& cluster = clusters[clusterAt(from.x, from.y)];
+    searchCluster(cluster, to, goalSearch);
+    Point current = from;
+    int distance = goalSearch.distance[localIndex(from.x, from.y, cluster.x0, cluster.y0, cluster.width)];
+    if (distance < 0) return false;
+
+    while (current != to) {
+        Point next = current;
+        forEachDirection<SquareTopology>([&](auto direction) {
+            constexpr GridOffset offset = SquareTopology::OFFSETS[0][decltype(direction)::value];
+            int nx = current.x + offset.dx;
+            int ny = current.y + offset.dy;
+            if (nx < cluster.x0 || ny < cluster.y0 ||
+                nx >= cluster.x0 + cluster.width || ny >= cluster.y0 + cluster.height) return;
+            if (goalSearch.distance[localIndex(nx, ny, cluster.x0, cluster.y0, cluster.width)] == distance - 1) {
+                next = Point(nx, ny);
+            }
+        });
+        current = next;
+        distance--;
+        path.push_back(current);
+    }
+    return true;
+}
+
+int HierarchicalPathfinder::findPath(const Point& from, const Point& to, std::vector<Point>& path) {
+    path.clear();
+    int length = findWaypoints(from, to, segmentWaypoints);
+    if (length < 0) return -1;
+
+    path.push_back(segmentWaypoints[0]);
+    for (std::size_t i = 1; i < segmentWaypoints.size(); ++i) {
+        const Point& a = segmentWaypoints[i - 1];
+        const Point& b = segmentWaypoints[i];
+        if (heuristic(a, b) == 1 && clusterAt(a.x, a.y) != clusterAt(b.x, b.y)) {
+            path.push_back(b);
+        } else if (!refineSegment(a, b, path)) {
+            path.clear();
+            return -1;
+        }
+    }
+    return length;
+}
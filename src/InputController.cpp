@@ -0,0 +1,105 @@
+// InputController.cpp
+#include "InputController.hpp"
+#include <algorithm>
+
+InputController::InputController(const Config& config)
+    : config(config)
+    , bufferHead(0)
+    , bufferCount(0)
+    , held()
+    , repeatDirection(-1)
+    , nextRepeat(0) {}
+
+GameSession::Action InputController::actionForKey(sf::Keyboard::Key key) {
+    switch (key) {
+        case sf::Keyboard::W:
+        case sf::Keyboard::Up:    return GameSession::Action::UP;
+        case sf::Keyboard::S:
+        case sf::Keyboard::Down:  return GameSession::Action::DOWN;
+        case sf::Keyboard::A:
+        case sf::Keyboard::Left:  return GameSession::Action::LEFT;
+        case sf::Keyboard::D:
+        case sf::Keyboard::Right: return GameSession::Action::RIGHT;
+        default: return GameSession::Action::NONE;
+    }
+}
+
+int InputController::directionIndex(GameSession::Action action) {
+    if (action < GameSession::Action::UP || action > GameSession::Action::RIGHT) return -1;
+    return static_cast<int>(action) - static_cast<int>(GameSession::Action::UP);
+}
+
+void InputController::keyPressed(GameSession::Action action, sf::Int64 timestamp) {
+    int direction = directionIndex(action);
+    if (direction < 0) return;
+
+    // A full buffer drops its oldest press rather than the newest.
+    if (bufferCount == BUFFER_SIZE) {
+        bufferHead = (bufferHead + 1) % BUFFER_SIZE;
+        bufferCount--;
+    }
+    buffer[(bufferHead + bufferCount) % BUFFER_SIZE] = {action, timestamp};
+    bufferCount++;
+
+    held[direction] = true;
+    repeatDirection = direction;
+    nextRepeat = timestamp + static_cast<sf::Int64>(config.repeatDelay * 1000000.0f);
+}
+
+void InputController::keyReleased(GameSession::Action action, sf::Int64 timestamp) {
+    int direction = directionIndex(action);
+    if (direction < 0) return;
+
+    held[direction] = false;
+    if (direction == repeatDirection) {
+        // Hand the repeat over to another direction that is still held. Its
+        // first repeat is one interval after the release, not whatever
+        // deadline the released key had reached.
+        repeatDirection = -1;
+        for (int i = 0; i < DIRECTIONS; ++i) {
+            if (held[i]) repeatDirection = i;
+        }
+        if (repeatDirection >= 0) {
+            nextRepeat = timestamp + static_cast<sf::Int64>(config.repeatInterval * 1000000.0f);
+        }
+    }
+}
+
+void InputController::reset() {
+    bufferHead = 0;
+    bufferCount = 0;
+    held.fill(false);
+    repeatDirection = -1;
+}
+
+std::size_t InputController::collect(sf::Int64 now, Command* out, std::size_t capacity) {
+    std::size_t count = 0;
+    while (bufferCount > 0 && count < capacity) {
+        out[count++] = buffer[bufferHead];
+        bufferHead = (bufferHead + 1) % BUFFER_SIZE;
+        bufferCount--;
+    }
+
+    if (repeatDirection < 0) return count;
+
+    const sf::Int64 interval = std::max<sf::Int64>(1, static_cast<sf::Int64>(config.repeatInterval * 1000000.0f));
+    auto action = static_cast<GameSession::Action>(static_cast<int>(GameSession::Action::UP) + repeatDirection);
+    for (int repeats = 0; nextRepeat <= now && count < capacity; ++repeats) {
+        if (repeats == config.maxRepeatsPerTick) {
+            // Too far behind (e.g. after a hitch): skip ahead instead of bursting.
+            nextRepeat = now + interval;
+            break;
+        }
+        out[count++] = {action, nextRepeat};
+        nextRepeat += interval;
+    }
+    return count;
+}
+
+void InputController::recordApplied(const Command& command, sf::Int64 appliedAt) {
+    float ms = static_cast<float>(appliedAt - command.timestamp) / 1000.0f;
+    latency.lastMs = ms;
+    latency.maxMs = std::max(latency.maxMs, ms);
+    latency.samples++;
+    latency.averageMs += (ms - latency.averageMs) / latency.samples;
+}
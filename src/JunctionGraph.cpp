@@ -0,0 +1,422 @@
+// JunctionGraph.cpp
+#include "JunctionGraph.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include "GridTopology.hpp"
+
+namespace {
+    const int INFINITE_COST = 0x3fffffff;
+
+    const GridOffset* const OFFSETS = SquareTopology::OFFSETS[0];
+
+    // SquareTopology pairs opposite directions: up/down, left/right.
+    int opposite(int direction) {
+        return direction ^ 1;
+    }
+}
+
+JunctionGraph::JunctionGraph()
+    : width(0)
+    , height(0)
+    , liveNodes(0)
+    , liveEdges(0)
+    , queryStamp(0)
+    , goalNode(-1)
+    , expanded(0) {
+}
+
+void JunctionGraph::build(const std::vector<std::vector<char>>& maze, const std::vector<Point>& landmarks) {
+    height = static_cast<int>(maze.size());
+    width = maze.empty() ? 0 : static_cast<int>(maze[0].size());
+    const std::size_t cellCount = static_cast<std::size_t>(width) * height;
+    grid.resize(cellCount);
+    int openCells = 0;
+    for (int y = 0; y < height; ++y) {
+        std::uint8_t* row = &grid[index(0, y)];
+        for (int x = 0; x < width; ++x) {
+            row[x] = maze[y][x] != '#';
+            openCells += row[x];
+        }
+    }
+    landmark.assign(cellCount, 0);
+    for (const Point& cell : landmarks) {
+        if (cell.x >= 0 && cell.y >= 0 && cell.x < width && cell.y < height) {
+            landmark[index(cell.x, cell.y)] = 1;
+        }
+    }
+
+    nodeAt.assign(cellCount, -1);
+    edgeAt.assign(cellCount, -1);
+    offsetAt.resize(cellCount);
+    links.resize(cellCount);
+    nodes.clear();
+    freeNodes.clear();
+    // Edge slots are recycled rather than cleared so rebuilding keeps their
+    // cell storage.
+    freeEdges.clear();
+    for (int edge = static_cast<int>(edges.size()) - 1; edge >= 0; --edge) {
+        edges[edge].live = false;
+        freeEdges.push_back(edge);
+    }
+    liveNodes = 0;
+    liveEdges = 0;
+
+    // Neighbour masks and nodes in one pass, reading the rows directly.
+    for (int y = 0; y < height; ++y) {
+        const std::uint8_t* row = &grid[index(0, y)];
+        for (int x = 0; x < width; ++x) {
+            std::uint8_t mask = 0;
+            if (row[x]) {
+                mask = static_cast<std::uint8_t>((y > 0 && row[x - width]) |
+                                                 (y + 1 < height && row[x + width]) << 1 |
+                                                 (x > 0 && row[x - 1]) << 2 |
+                                                 (x + 1 < width && row[x + 1]) << 3);
+            }
+            links[index(x, y)] = mask;
+            if (row[x] && (landmark[index(x, y)] || __builtin_popcount(mask) != 2)) {
+                createNode(x, y);
+            }
+        }
+    }
+    int assigned = liveNodes;
+    for (int node = 0; node < static_cast<int>(nodes.size()); ++node) {
+        for (int direction = 0; direction < SquareTopology::DIRECTIONS; ++direction) {
+            if (nodes[node].edges[direction] < 0) {
+                trace(node, direction);
+                int edge = nodes[node].edges[direction];
+                if (edge >= 0) assigned += static_cast<int>(edges[edge].cells.size());
+            }
+        }
+    }
+
+    // Whatever is still unassigned lies on closed loops with no node at all.
+    if (assigned < openCells) {
+        released.clear();
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (grid[index(x, y)] && nodeAt[index(x, y)] < 0 && edgeAt[index(x, y)] < 0) {
+                    released.emplace_back(x, y);
+                }
+            }
+        }
+        promoteRings(released);
+    }
+
+    visited.assign(nodes.size(), 0);
+    queryStamp = 0;
+}
+
+void JunctionGraph::setCell(int x, int y, bool open) {
+    if (x < 0 || y < 0 || x >= width || y >= height || grid[index(x, y)] == open) return;
+
+    // The cell and its neighbours are the only cells whose degree changes, so
+    // only their nodes and the corridors through them need re-tracing.
+    Point dirty[5];
+    int dirtyCount = 0;
+    dirty[dirtyCount++] = Point(x, y);
+    for (int direction = 0; direction < SquareTopology::DIRECTIONS; ++direction) {
+        int nx = x + OFFSETS[direction].dx;
+        int ny = y + OFFSETS[direction].dy;
+        if (nx >= 0 && ny >= 0 && nx < width && ny < height) {
+            dirty[dirtyCount++] = Point(nx, ny);
+        }
+    }
+
+    frontier.clear();
+    released.clear();
+    for (int i = 0; i < dirtyCount; ++i) {
+        std::size_t cell = index(dirty[i].x, dirty[i].y);
+        if (nodeAt[cell] >= 0) {
+            removeNode(nodeAt[cell]);
+        } else if (edgeAt[cell] >= 0) {
+            removeEdge(edgeAt[cell]);
+        }
+    }
+
+    grid[index(x, y)] = open;
+    for (int i = 0; i < dirtyCount; ++i) {
+        updateLinks(dirty[i].x, dirty[i].y);
+    }
+    for (int i = 0; i < dirtyCount; ++i) {
+        if (isNodeCell(dirty[i].x, dirty[i].y)) {
+            frontier.push_back(createNode(dirty[i].x, dirty[i].y));
+        }
+        released.push_back(dirty[i]);
+    }
+    for (int node : frontier) {
+        if (!nodes[node].live) continue;
+        for (int direction = 0; direction < SquareTopology::DIRECTIONS; ++direction) {
+            trace(node, direction);
+        }
+    }
+    promoteRings(released);
+}
+
+void JunctionGraph::updateLinks(int x, int y) {
+    std::uint8_t mask = 0;
+    for (int direction = 0; grid[index(x, y)] && direction < SquareTopology::DIRECTIONS; ++direction) {
+        if (isOpen(x + OFFSETS[direction].dx, y + OFFSETS[direction].dy)) {
+            mask |= 1 << direction;
+        }
+    }
+    links[index(x, y)] = mask;
+}
+
+bool JunctionGraph::isNodeCell(int x, int y) const {
+    std::size_t cell = index(x, y);
+    return grid[cell] && (landmark[cell] || __builtin_popcount(links[cell]) != 2);
+}
+
+int JunctionGraph::createNode(int x, int y) {
+    int node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        node = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+    }
+    Node& created = nodes[node];
+    created.position = Point(x, y);
+    created.edges.fill(-1);
+    created.live = true;
+    nodeAt[index(x, y)] = node;
+    liveNodes++;
+    return node;
+}
+
+void JunctionGraph::removeNode(int node) {
+    Node& removed = nodes[node];
+    for (int direction = 0; direction < SquareTopology::DIRECTIONS; ++direction) {
+        if (removed.edges[direction] >= 0) {
+            removeEdge(removed.edges[direction]);
+        }
+    }
+    nodeAt[index(removed.position.x, removed.position.y)] = -1;
+    removed.live = false;
+    freeNodes.push_back(node);
+    liveNodes--;
+}
+
+void JunctionGraph::removeEdge(int edge) {
+    Edge& removed = edges[edge];
+    nodes[removed.from].edges[removed.fromDirection] = -1;
+    nodes[removed.to].edges[removed.toDirection] = -1;
+    frontier.push_back(removed.from);
+    frontier.push_back(removed.to);
+    for (const Point& cell : removed.cells) {
+        edgeAt[index(cell.x, cell.y)] = -1;
+        released.push_back(cell);
+    }
+    removed.live = false;
+    freeEdges.push_back(edge);
+    liveEdges--;
+}
+
+void JunctionGraph::trace(int node, int direction) {
+    if (nodes[node].edges[direction] >= 0) return;
+    const Point origin = nodes[node].position;
+    int x = origin.x + OFFSETS[direction].dx;
+    int y = origin.y + OFFSETS[direction].dy;
+    if (!isOpen(x, y)) return;
+
+    int edge;
+    if (!freeEdges.empty()) {
+        edge = freeEdges.back();
+        freeEdges.pop_back();
+    } else {
+        edge = static_cast<int>(edges.size());
+        edges.emplace_back();
+    }
+    Edge& traced = edges[edge];
+    traced.cells.clear();
+
+    // Corridor cells have exactly two open neighbours: keep leaving by the
+    // one we did not arrive from.
+    int heading = direction;
+    for (std::size_t cell = index(x, y); nodeAt[cell] < 0; cell = index(x, y)) {
+        edgeAt[cell] = edge;
+        traced.cells.emplace_back(x, y);
+        offsetAt[cell] = static_cast<int>(traced.cells.size());
+        heading = __builtin_ctz(links[cell] & ~(1u << opposite(heading)));
+        x += OFFSETS[heading].dx;
+        y += OFFSETS[heading].dy;
+    }
+
+    traced.from = node;
+    traced.to = nodeAt[index(x, y)];
+    traced.fromDirection = direction;
+    traced.toDirection = opposite(heading);
+    traced.length = static_cast<int>(traced.cells.size()) + 1;
+    traced.live = true;
+    nodes[traced.from].edges[traced.fromDirection] = edge;
+    nodes[traced.to].edges[traced.toDirection] = edge;
+    liveEdges++;
+}
+
+void JunctionGraph::promoteRings(const std::vector<Point>& cells) {
+    for (const Point& cell : cells) {
+        std::size_t i = index(cell.x, cell.y);
+        if (grid[i] && nodeAt[i] < 0 && edgeAt[i] < 0) {
+            int node = createNode(cell.x, cell.y);
+            for (int direction = 0; direction < SquareTopology::DIRECTIONS; ++direction) {
+                trace(node, direction);
+            }
+        }
+    }
+}
+
+int JunctionGraph::heuristic(const Point& from, const Point& to) const {
+    return std::abs(from.x - to.x) + std::abs(from.y - to.y);
+}
+
+bool JunctionGraph::anchor(const Point& cell, Anchor& result) const {
+    if (!isOpen(cell.x, cell.y)) return false;
+    std::size_t i = index(cell.x, cell.y);
+    result.node = nodeAt[i];
+    result.edge = edgeAt[i];
+    result.offset = result.node < 0 ? offsetAt[i] : 0;
+    return true;
+}
+
+int JunctionGraph::distance(const Point& from, const Point& to) {
+    return search(from, to);
+}
+
+int JunctionGraph::search(const Point& from, const Point& to) {
+    expanded = 0;
+    goalNode = -1;
+    if (!anchor(from, start) || !anchor(to, goal)) return -1;
+    if (from == to) return 0;
+
+    int best = INFINITE_COST;
+    if (start.node < 0 && start.edge == goal.edge) {
+        best = std::abs(start.offset - goal.offset);
+    }
+
+    if (gScore.size() < nodes.size()) {
+        gScore.resize(nodes.size());
+        parentEdge.resize(nodes.size());
+        parentNode.resize(nodes.size());
+        visited.resize(nodes.size(), 0);
+    }
+    if (++queryStamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        queryStamp = 1;
+    }
+    open.clear();
+    auto key = [&](int cost, const Point& cell) {
+        return (static_cast<std::int64_t>(cost + heuristic(cell, to)) << 32) - cost;
+    };
+    auto relax = [&](int node, int cost, int edge, int previous) {
+        if (visited[node] == queryStamp && gScore[node] <= cost) return;
+        visited[node] = queryStamp;
+        gScore[node] = cost;
+        parentEdge[node] = edge;
+        parentNode[node] = previous;
+        open.emplace_back(key(cost, nodes[node].position), node);
+        std::push_heap(open.begin(), open.end(), std::greater<std::pair<std::int64_t, int>>());
+    };
+
+    if (start.node >= 0) {
+        relax(start.node, 0, -1, -1);
+    } else {
+        const Edge& edge = edges[start.edge];
+        relax(edge.from, start.offset, -1, -1);
+        relax(edge.to, edge.length - start.offset, -1, -1);
+    }
+
+    while (!open.empty()) {
+        std::pair<std::int64_t, int> top = open.front();
+        std::pop_heap(open.begin(), open.end(), std::greater<std::pair<std::int64_t, int>>());
+        open.pop_back();
+
+        int node = top.second;
+        const Node& current = nodes[node];
+        int cost = gScore[node];
+        if (top.first != key(cost, current.position)) continue;  // Stale entry
+        if (cost + heuristic(current.position, to) >= best) break;
+        expanded++;
+
+        if (goal.node >= 0) {
+            if (node == goal.node) {
+                best = cost;
+                goalNode = node;
+                break;
+            }
+        } else {
+            const Edge& edge = edges[goal.edge];
+            if (node == edge.from && cost + goal.offset < best) {
+                best = cost + goal.offset;
+                goalNode = node;
+            }
+            if (node == edge.to && cost + edge.length - goal.offset < best) {
+                best = cost + edge.length - goal.offset;
+                goalNode = node;
+            }
+        }
+
+        for (int direction = 0; direction < SquareTopology::DIRECTIONS; ++direction) {
+            int edge = current.edges[direction];
+            if (edge < 0) continue;
+            const Edge& next = edges[edge];
+            int other = next.from == node && next.fromDirection == direction ? next.to : next.from;
+            relax(other, cost + next.length, edge, node);
+        }
+    }
+    return best == INFINITE_COST ? -1 : best;
+}
+
+int JunctionGraph::findPath(const Point& from, const Point& to, std::vector<Point>& path) {
+    path.clear();
+    int length = search(from, to);
+    if (length < 0) return -1;
+    path.push_back(from);
+    if (length == 0) return 0;
+
+    if (goalNode < 0) {
+        // Both ends on one corridor, with the direct route the shortest.
+        appendEdge(start.edge, start.offset, goal.offset, path);
+        return length;
+    }
+
+    // Nodes from the goal side back to a source, replayed forwards.
+    chain.clear();
+    for (int node = goalNode; node >= 0; node = parentNode[node]) {
+        chain.push_back(node);
+    }
+
+    if (start.node < 0) {
+        const Edge& edge = edges[start.edge];
+        int first = chain.back();
+        bool viaFrom = first == edge.from && (edge.from != edge.to || gScore[first] == start.offset);
+        appendEdge(start.edge, start.offset, viaFrom ? 0 : edge.length, path);
+    }
+    for (std::size_t i = chain.size() - 1; i > 0; --i) {
+        int edge = parentEdge[chain[i - 1]];
+        bool forwards = edges[edge].from == chain[i];
+        appendEdge(edge, forwards ? 0 : edges[edge].length, forwards ? edges[edge].length : 0, path);
+    }
+    if (goal.node < 0) {
+        const Edge& edge = edges[goal.edge];
+        bool viaFrom = goalNode == edge.from && (edge.from != edge.to || gScore[goalNode] + goal.offset == length);
+        appendEdge(goal.edge, viaFrom ? 0 : edge.length, goal.offset, path);
+    }
+    return length;
+}
+
+Point JunctionGraph::edgePoint(const Edge& edge, int offset) const {
+    if (offset == 0) return nodes[edge.from].position;
+    if (offset == edge.length) return nodes[edge.to].position;
+    return edge.cells[offset - 1];
+}
+
+void JunctionGraph::appendEdge(int edge, int fromOffset, int toOffset, std::vector<Point>& path) const {
+    const Edge& walked = edges[edge];
+    int step = toOffset > fromOffset ? 1 : -1;
+    for (int offset = fromOffset; offset != toOffset;) {
+        offset += step;
+        path.push_back(edgePoint(walked, offset));
+    }
+}
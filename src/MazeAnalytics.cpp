@@ -0,0 +1,227 @@
+// MazeAnalytics.cpp
+#include "MazeAnalytics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+    // Open cells packed 64 to a word, one row after another.
+    struct BitGrid {
+        int width, height, wordsPerRow;
+        std::uint64_t* bits;
+
+        BitGrid(const std::vector<std::vector<char>>& maze, LinearArena& arena)
+            : width(maze.empty() ? 0 : static_cast<int>(maze[0].size()))
+            , height(static_cast<int>(maze.size()))
+            , wordsPerRow((width + 63) / 64)
+            , bits(arena.allocate<std::uint64_t>(static_cast<std::size_t>(wordsPerRow) * height)) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    if (maze[y][x] != '#') {
+                        bits[y * wordsPerRow + x / 64] |= std::uint64_t(1) << (x % 64);
+                    }
+                }
+            }
+        }
+
+        std::uint64_t word(int y, int w) const {
+            if (y < 0 || y >= height || w < 0 || w >= wordsPerRow) return 0;
+            return bits[y * wordsPerRow + w];
+        }
+    };
+
+    // Counts dead ends (one open neighbour) and junctions (three or more) for
+    // 64 cells at a time by summing the four neighbour masks bit-sliced.
+    void countNodes(const BitGrid& grid, int& deadEnds, int& junctions) {
+        deadEnds = 0;
+        junctions = 0;
+        for (int y = 0; y < grid.height; ++y) {
+            for (int w = 0; w < grid.wordsPerRow; ++w) {
+                std::uint64_t self = grid.word(y, w);
+                if (!self) continue;
+
+                std::uint64_t up = grid.word(y - 1, w);
+                std::uint64_t down = grid.word(y + 1, w);
+                std::uint64_t left = (self << 1) | (grid.word(y, w - 1) >> 63);
+                std::uint64_t right = (self >> 1) | (grid.word(y, w + 1) << 63);
+
+                std::uint64_t s = up ^ down, c1 = up & down;
+                std::uint64_t t = left ^ right, c2 = left & right;
+                std::uint64_t bit0 = s ^ t, c3 = s & t;
+                std::uint64_t bit1 = c1 ^ c2 ^ c3;
+                std::uint64_t bit2 = (c1 & c2) | (c1 & c3) | (c2 & c3);
+
+                deadEnds += __builtin_popcountll(self & bit0 & ~bit1 & ~bit2);
+                junctions += __builtin_popcountll(self & ((bit0 & bit1) | bit2));
+            }
+        }
+    }
+
+    const int DX[4] = {0, 0, -1, 1};
+    const int DY[4] = {-1, 1, 0, 0};
+
+    int corridorBucket(int length) {
+        if (length <= 1) return 0;
+        int bucket = 1;
+        for (int span = length - 1; span > 1; span >>= 1) {
+            bucket++;
+        }
+        return std::min(bucket, MazeAnalytics::CORRIDOR_BUCKETS - 1);
+    }
+}
+
+namespace MazeAnalytics {
+
+Metrics analyze(const GameSession& session) {
+    Workspace workspace;
+    return analyze(session, workspace);
+}
+
+Metrics analyze(const GameSession& session, Workspace& workspace) {
+    const auto& maze = session.getMaze();
+    Metrics metrics;
+    if (maze.empty()) return metrics;
+
+    LinearArena& scratch = workspace.scratch;
+    JunctionGraph& graph = workspace.graph;
+    scratch.reset();
+    BitGrid grid(maze, scratch);
+    const int width = grid.width;
+    const int height = grid.height;
+    const std::size_t cellCount = static_cast<std::size_t>(width) * height;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(grid.wordsPerRow) * height; ++i) {
+        metrics.openCells += __builtin_popcountll(grid.bits[i]);
+    }
+    countNodes(grid, metrics.deadEnds, metrics.junctions);
+
+    auto isOpen = [&](int x, int y) {
+        return x >= 0 && y >= 0 && x < width && y < height && maze[y][x] != '#';
+    };
+
+    // Corridors are the junction graph's edges; extra choices come from the
+    // number of edges leaving each junction.
+    graph.build(maze);
+    auto nodeDegree = [&](int node) {
+        int count = 0;
+        for (int edge : graph.getNodes()[node].edges) count += edge >= 0;
+        return count;
+    };
+    int extraChoices = 0;
+    for (int node = 0; node < static_cast<int>(graph.getNodes().size()); ++node) {
+        int degree = nodeDegree(node);
+        if (graph.getNodes()[node].live && degree >= 3) extraChoices += degree - 1;
+    }
+    for (const auto& edge : graph.getEdges()) {
+        if (!edge.live || edge.cells.empty()) continue;
+        // A closed ring with no junction on it is not a corridor.
+        if (edge.from == edge.to && nodeDegree(edge.from) == 2) continue;
+        metrics.corridorLengths[corridorBucket(static_cast<int>(edge.cells.size()))]++;
+    }
+    if (metrics.junctions > 0) {
+        metrics.branchingFactor = static_cast<float>(extraChoices) / metrics.junctions;
+    }
+
+    std::vector<Point>& solution = workspace.solution;
+    metrics.solutionLength = graph.findPath(session.getPlayerPos(), session.getEndPos(), solution);
+
+    // Multi-source search from enemy spawns, bounded by ENEMY_REACH.
+    int* enemyDistance = scratch.allocate<int>(cellCount);
+    std::fill(enemyDistance, enemyDistance + cellCount, -1);
+    int* queue = scratch.allocate<int>(cellCount);
+    std::size_t queueSize = 0;
+    for (const auto& enemy : session.getEnemies()) {
+        const Point& pos = enemy.getPosition();
+        if (isOpen(pos.x, pos.y) && enemyDistance[pos.y * width + pos.x] < 0) {
+            enemyDistance[pos.y * width + pos.x] = 0;
+            queue[queueSize++] = pos.y * width + pos.x;
+        }
+    }
+    for (std::size_t head = 0; head < queueSize; ++head) {
+        int cell = queue[head];
+        if (enemyDistance[cell] >= ENEMY_REACH) continue;
+        int cx = cell % width, cy = cell / width;
+        for (int d = 0; d < 4; ++d) {
+            int nx = cx + DX[d], ny = cy + DY[d];
+            if (isOpen(nx, ny) && enemyDistance[ny * width + nx] < 0) {
+                enemyDistance[ny * width + nx] = enemyDistance[cell] + 1;
+                queue[queueSize++] = ny * width + nx;
+            }
+        }
+    }
+
+    for (const Point& cell : solution) {
+        if (enemyDistance[cell.y * width + cell.x] >= 0) metrics.exposedSolutionCells++;
+    }
+
+    metrics.difficultyScore = metrics.solutionLength + 0.5f * metrics.deadEnds +
+                              2.0f * metrics.exposedSolutionCells;
+    return metrics;
+}
+
+std::vector<Metrics> analyzeBatch(GameSession::Difficulty difficulty, unsigned firstSeed,
+                                  std::size_t count, unsigned threadCount) {
+    std::vector<Metrics> results(count);
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::size_t blockSize = 256;
+    std::atomic<std::size_t> nextBlock(0);
+    auto worker = [&]() {
+        Workspace workspace;
+        GameSession session(difficulty);
+        while (true) {
+            std::size_t begin = nextBlock.fetch_add(blockSize);
+            if (begin >= count) break;
+            std::size_t end = std::min(count, begin + blockSize);
+            for (std::size_t i = begin; i < end; ++i) {
+                unsigned seed = firstSeed + static_cast<unsigned>(i);
+                session.setSeed(seed);
+                session.generateMaze();
+                results[i] = analyze(session, workspace);
+                results[i].seed = seed;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+std::vector<float> calibrateTiers(std::vector<Metrics>& results, int tierCount) {
+    std::vector<float> boundaries;
+    if (results.empty() || tierCount < 2) {
+        for (auto& metrics : results) metrics.tier = 0;
+        return boundaries;
+    }
+
+    std::vector<float> scores;
+    scores.reserve(results.size());
+    for (const auto& metrics : results) {
+        scores.push_back(metrics.difficultyScore);
+    }
+    std::sort(scores.begin(), scores.end());
+    for (int i = 1; i < tierCount; ++i) {
+        boundaries.push_back(scores[scores.size() * i / tierCount]);
+    }
+
+    for (auto& metrics : results) {
+        metrics.tier = classify(metrics.difficultyScore, boundaries);
+    }
+    return boundaries;
+}
+
+int classify(float difficultyScore, const std::vector<float>& boundaries) {
+    return static_cast<int>(std::upper_bound(boundaries.begin(), boundaries.end(), difficultyScore) -
+                            boundaries.begin());
+}
+
+}
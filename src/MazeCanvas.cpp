@@ -0,0 +1,73 @@
+// MazeCanvas.cpp
+#include "MazeCanvas.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+MazeCanvas::MazeCanvas()
+    : width(0), height(0)
+    , dirtyLeft(0), dirtyTop(0), dirtyRight(-1), dirtyBottom(-1) {}
+
+bool MazeCanvas::resize(int newWidth, int newHeight) {
+    if (newWidth == width && newHeight == height) {
+        return true;
+    }
+    width = newWidth;
+    height = newHeight;
+    pixels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+    dirtyLeft = 0;
+    dirtyRight = -1;
+
+    if (!texture.create(width, height)) {
+        std::cerr << "Could not create a " << width << "x" << height << " maze texture" << std::endl;
+        return false;
+    }
+    sprite.setTexture(texture, true);
+    return true;
+}
+
+void MazeCanvas::setCell(int x, int y, const sf::Color& color) {
+    sf::Uint8* pixel = &pixels[(static_cast<std::size_t>(y) * width + x) * 4];
+    pixel[0] = color.r;
+    pixel[1] = color.g;
+    pixel[2] = color.b;
+    pixel[3] = color.a;
+
+    if (dirtyLeft > dirtyRight) {
+        dirtyLeft = dirtyRight = x;
+        dirtyTop = dirtyBottom = y;
+    } else {
+        dirtyLeft = std::min(dirtyLeft, x);
+        dirtyRight = std::max(dirtyRight, x);
+        dirtyTop = std::min(dirtyTop, y);
+        dirtyBottom = std::max(dirtyBottom, y);
+    }
+}
+
+void MazeCanvas::flush(LinearArena& scratch) {
+    if (dirtyLeft > dirtyRight) return;
+
+    unsigned rectWidth = dirtyRight - dirtyLeft + 1;
+    unsigned rectHeight = dirtyBottom - dirtyTop + 1;
+    const sf::Uint8* source = &pixels[(static_cast<std::size_t>(dirtyTop) * width + dirtyLeft) * 4];
+
+    if (static_cast<int>(rectWidth) == width) {
+        // Full rows are already contiguous.
+        texture.update(source, rectWidth, rectHeight, dirtyLeft, dirtyTop);
+    } else {
+        sf::Uint8* packed = scratch.allocate<sf::Uint8>(static_cast<std::size_t>(rectWidth) * rectHeight * 4);
+        for (unsigned row = 0; row < rectHeight; ++row) {
+            std::memcpy(packed + row * rectWidth * 4, source + static_cast<std::size_t>(row) * width * 4,
+                        rectWidth * 4);
+        }
+        texture.update(packed, rectWidth, rectHeight, dirtyLeft, dirtyTop);
+    }
+
+    dirtyLeft = 0;
+    dirtyRight = -1;
+}
+
+void MazeCanvas::draw(sf::RenderWindow& window, float cellSize) {
+    sprite.setScale(cellSize, cellSize);
+    window.draw(sprite);
+}
@@ -3,27 +3,62 @@
 #include "Constants.hpp"
 #include "ResourceManager.hpp"
 #include <vector>
-#include <stack>
-#include <random>
 #include <ctime>
-#include <sstream>
+#include <cstdio>
 #include <algorithm>
 #include <fstream>
-
-MazeGame::MazeGame()
-    : state(GameState::DIFFICULTY_SELECT)
-    , difficulty(Difficulty::MEDIUM)
-    , showSolution(false)
+#include <chrono>
+
+MazeGame::MazeGame(FramePacer::Policy pacing, const std::string& telemetryPath)
+    : frameArena(4096)
+    , canvasGridVersion(0)
+    , canvasStale(true)
+    , pathfinderGridVersion(0)
+    , pacer(pacing)
+    , gameGeneration(0)
+    , droppedFrameSamples(0)
+    , simulationRunning(false)
+    , simulationIdle(false)
+    , session(Difficulty::MEDIUM)
+    , rewindBuffer(GameConstants::REWIND_TICKS)
+    , publishedGridVersion(0)
+    , simulationTick(0)
+    , activeGeneration(0)
+    , simulating(false)
+    , rewinding(false)
+    , gameOver(false)
+    , state(GameState::DIFFICULTY_SELECT)
     , cellSize(GameConstants::BASE_CELL_SIZE)
-    , stats() {
+    , showSolution(false)
+    , showMetrics(false)
+    , fogOfWar(false) {
     std::srand(static_cast<unsigned>(std::time(nullptr)));
     initialize();
+    audio.start();
+    if (!telemetryPath.empty()) {
+        telemetry.start(telemetryPath);
+    }
+
+    simulationRunning.store(true, std::memory_order_release);
+    simulation = std::thread(&MazeGame::simulationLoop, this);
+}
+
+MazeGame::~MazeGame() {
+    simulationRunning.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(simulationMutex);
+        simulationWake.notify_one();
+    }
+    if (simulation.joinable()) {
+        simulation.join();
+    }
 }
 
 void MazeGame::saveHighScore() {
     try {
         std::ofstream file("highscore.dat", std::ios::binary);
         if (file.is_open()) {
+            const GameStats& stats = session.getStats();
             file.write(reinterpret_cast<const char*>(&stats.highScore), sizeof(stats.highScore));
             file.close();
         }
@@ -33,6 +68,7 @@ void MazeGame::saveHighScore() {
 }
 
 void MazeGame::loadHighScore() {
+    GameStats& stats = session.getStats();
     try {
         std::ifstream file("highscore.dat", std::ios::binary);
         if (file.is_open()) {
@@ -49,7 +85,9 @@ void MazeGame::loadHighScore() {
 void MazeGame::initialize() {
     window.create(sf::VideoMode(GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT),
                  "Maze Game - " + GameInfo::CURRENT_USER);
-    window.setFramerateLimit(60);
+    pacer.apply(window);
+    // Held keys repeat through InputController at the tick rate instead.
+    window.setKeyRepeatEnabled(false);
 
     gameView = window.getDefaultView();
     minimapView = sf::View(sf::FloatRect(0, 0, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT));
@@ -62,13 +100,33 @@ void MazeGame::initialize() {
     statusText.setFillColor(sf::Color::White);
     statusText.setPosition(10.f, 10.f);
 
+    titleText.setFont(ResourceManager::getInstance().getFont());
+    titleText.setString("Select Difficulty");
+    titleText.setCharacterSize(40);
+    titleText.setFillColor(sf::Color::White);
+    sf::FloatRect titleBounds = titleText.getLocalBounds();
+    titleText.setPosition(
+        (GameConstants::SCREEN_WIDTH - titleBounds.width) / 2.f,
+        GameConstants::SCREEN_HEIGHT * 0.15f
+    );
+
+    gameOverText.setFont(ResourceManager::getInstance().getFont());
+    gameOverText.setCharacterSize(30);
+    gameOverText.setFillColor(sf::Color::White);
+
     loadHighScore();
     GameInfo::printGameInfo();
 }
 
 void MazeGame::startNewGame() {
-    stats.resetForNewGame();
-    generateMaze();
+    session.startNewGame();
+    rewindBuffer.clear();
+    input.reset();
+    input.resetLatency();
+    simulating = true;
+    rewinding = false;
+    gameOver = false;
+    telemetry.record(Telemetry::EventType::SESSION_START, static_cast<int>(session.getDifficulty()));
 }
 
 void MazeGame::createButtons() {
@@ -102,80 +160,147 @@ void MazeGame::createButtons() {
 
 void MazeGame::run() {
     while (window.isOpen()) {
-        float deltaTime = gameClock.restart().asSeconds();
-        
-        switch (state) {
-            case GameState::DIFFICULTY_SELECT:
-                handleDifficultySelection();
+        frameArena.reset();
+
+        if (state != GameState::PLAYING) {
+            // Nothing animates outside of play, so draw once and sleep
+            // until the next event instead of redrawing every frame.
+            if (state == GameState::DIFFICULTY_SELECT) {
+                for (auto& button : buttons) {
+                    button->update(window);
+                }
                 drawDifficultyMenu();
-                break;
-                
-            case GameState::PLAYING:
-                handleInput();
-                update(deltaTime);
-                render();
-                break;
-                
-            case GameState::PAUSED:
-                handleInput();
+            } else {
                 render();
-                break;
-                
-            case GameState::GAME_OVER:
-                handleInput();
-                render();
-                break;
-                
-            default:
-                break;
+            }
+            waitForEvent();
+            continue;
+        }
+
+        pacer.beginFrame();
+        float deltaTime = gameClock.restart().asSeconds();
+        handleInput();
+        render();
+        pacer.endFrame();
+
+        const FramePacer::FrameStats& frames = pacer.getStats();
+        FrameSample sample;
+        sample.frameMicros = static_cast<std::int32_t>(deltaTime * 1000000.0f);
+        sample.jitterMicros = static_cast<std::int32_t>(frames.jitterMs * 1000.0f);
+        if (!frameSamples.tryPush(sample)) {
+            droppedFrameSamples.fetch_add(1, std::memory_order_relaxed);
         }
     }
 }
 
-void MazeGame::handleDifficultySelection() {
+void MazeGame::waitForEvent() {
     sf::Event event;
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
-            return;
-        }
+    if (!window.waitEvent(event)) {
+        return;
+    }
 
-        for (size_t i = 0; i < buttons.size(); i++) {
-            if (buttons[i]->isClicked(event, window)) {
-                switch(i) {
-                    case 0: difficulty = Difficulty::EASY; break;
-                    case 1: difficulty = Difficulty::MEDIUM; break;
-                    case 2: difficulty = Difficulty::HARD; break;
-                }
-                state = GameState::PLAYING;
-                startNewGame();
-                return;
-            }
+    do {
+        if (state == GameState::DIFFICULTY_SELECT) {
+            handleMenuEvent(event);
+        } else {
+            handleGameEvent(event);
         }
+    } while (window.isOpen() && window.pollEvent(event));
+
+    // Idle time must not show up as one huge frame.
+    pacer.resync();
+    gameClock.restart();
+}
+
+void MazeGame::handleMenuEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+        return;
     }
 
-    for (auto& button : buttons) {
-        button->update(window);
+    for (size_t i = 0; i < buttons.size(); i++) {
+        if (buttons[i]->isClicked(event, window)) {
+            switch(i) {
+                case 0: startGame(Difficulty::EASY); break;
+                case 1: startGame(Difficulty::MEDIUM); break;
+                case 2: startGame(Difficulty::HARD); break;
+            }
+            return;
+        }
     }
 }
 
 void MazeGame::handleInput() {
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
-        }
-        else if (event.type == sf::Event::KeyPressed) {
+        handleGameEvent(event);
+    }
+}
+
+void MazeGame::handleGameEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    else if (event.type == sf::Event::KeyPressed) {
+        GameSession::Action action = InputController::actionForKey(event.key.code);
+        if (action != GameSession::Action::NONE) {
+            if (state == GameState::PLAYING) {
+                post(Command::Type::KEY_PRESSED, action);
+            }
+        } else {
             handleKeyPress(event.key.code);
         }
     }
+    else if (event.type == sf::Event::KeyReleased) {
+        if (event.key.code == sf::Keyboard::BackSpace) {
+            post(Command::Type::REWIND_STOP);
+        }
+        post(Command::Type::KEY_RELEASED, InputController::actionForKey(event.key.code));
+    }
+    else if (event.type == sf::Event::LostFocus) {
+        post(Command::Type::RESET_INPUT);
+        post(Command::Type::REWIND_STOP);
+    }
+}
+
+void MazeGame::post(Command::Type type, GameSession::Action action) {
+    Command command;
+    command.type = type;
+    command.action = action;
+    command.difficulty = Difficulty::MEDIUM;
+    command.generation = gameGeneration;
+    command.timestamp = input.now();    // The input clock is only read, never restarted
+    pushCommand(command);
+}
+
+void MazeGame::pushCommand(const Command& command) {
+    // Only overflows if the simulation thread has stalled for 256 commands.
+    commands.tryPush(command);
+
+    // Pairs with the fence in waitForCommand(): either the simulation thread
+    // sees this command when it rechecks the queue, or this sees it idle.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (simulationIdle.exchange(false)) {
+        std::lock_guard<std::mutex> lock(simulationMutex);
+        simulationWake.notify_one();
+    }
+}
+
+void MazeGame::startGame(Difficulty difficulty) {
+    Command command;
+    command.type = Command::Type::START_GAME;
+    command.action = GameSession::Action::NONE;
+    command.difficulty = difficulty;
+    command.generation = ++gameGeneration;
+    command.timestamp = input.now();
+    pushCommand(command);
+    state = GameState::PLAYING;
 }
 
 void MazeGame::handleKeyPress(sf::Keyboard::Key key) {
     if (state == GameState::GAME_OVER) {
         if (key == sf::Keyboard::Escape) {
             state = GameState::DIFFICULTY_SELECT;
-            stats.resetForNewGame();
             return;
         }
         return;
@@ -184,6 +309,7 @@ void MazeGame::handleKeyPress(sf::Keyboard::Key key) {
     if (state == GameState::PAUSED) {
         if (key == sf::Keyboard::Escape) {
             state = GameState::PLAYING;
+            post(Command::Type::RESUME);
         }
         return;
     }
@@ -192,88 +318,241 @@ void MazeGame::handleKeyPress(sf::Keyboard::Key key) {
         return;
     }
 
-    Point newPos = playerPos;
-    bool moved = false;
-
     switch (key) {
-        case sf::Keyboard::W:
-        case sf::Keyboard::Up:    newPos.y--; moved = true; break;
-        case sf::Keyboard::S:
-        case sf::Keyboard::Down:  newPos.y++; moved = true; break;
-        case sf::Keyboard::A:
-        case sf::Keyboard::Left:  newPos.x--; moved = true; break;
-        case sf::Keyboard::D:
-        case sf::Keyboard::Right: newPos.x++; moved = true; break;
         case sf::Keyboard::Space: showSolution = !showSolution; break;
-        case sf::Keyboard::Escape: state = GameState::PAUSED; break;
+        case sf::Keyboard::F3: showMetrics = !showMetrics; break;
+        case sf::Keyboard::F:
+            fogOfWar = !fogOfWar;
+            canvasStale = true;
+            break;
+        case sf::Keyboard::Escape:
+            state = GameState::PAUSED;
+            post(Command::Type::PAUSE);
+            break;
         case sf::Keyboard::R: 
-            startNewGame();
+            ++gameGeneration;
+            post(Command::Type::RESTART);
             break;
+        case sf::Keyboard::M: audio.setMuted(!audio.isMuted()); break;
+        case sf::Keyboard::BackSpace: post(Command::Type::REWIND_START); break;
         default: break;
     }
+}
 
-    if (moved && isValidMove(newPos)) {
-        movePlayer(newPos);
-        if (newPos == endPos) {
-            updateScore();
-            generateMaze();
-            stats.moveCount = 0;
-            stats.timeElapsed = 0.0f;
+void MazeGame::applyQueuedMoves() {
+    InputController::Command commands[InputController::BUFFER_SIZE];
+    std::size_t count = input.collect(input.now(), commands, InputController::BUFFER_SIZE);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const GameStats& stats = session.getStats();
+        int previousHighScore = stats.highScore;
+        int levelMoves = stats.moveCount + 1;
+        int levelTimeMs = static_cast<int>(stats.timeElapsed * 1000.0f);
+
+        GameSession::StepResult result = session.applyAction(commands[i].action);
+        if (result == GameSession::StepResult::NONE) continue;
+
+        input.recordApplied(commands[i], input.now());
+        if (result == GameSession::StepResult::LEVEL_COMPLETE) {
+            telemetry.record(Telemetry::EventType::LEVEL_COMPLETE, stats.score, levelMoves, levelTimeMs);
+            audio.play(AudioEngine::Cue::LEVEL_COMPLETE);
+            if (stats.highScore > previousHighScore) {
+                saveHighScore();
+            }
+        } else {
+            const Point& position = session.getPlayerPos();
+            telemetry.record(Telemetry::EventType::MOVE, position.x, position.y);
+            audio.play(AudioEngine::Cue::MOVE, 40.0f);
         }
     }
 }
 
-void MazeGame::update(float deltaTime) {
-    if (state != GameState::PLAYING) return;
+void MazeGame::simulationLoop() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration tickLength = std::chrono::microseconds(1000000 / GameConstants::SIMULATION_TICK_RATE);
+    const float deltaTime = 1.0f / GameConstants::SIMULATION_TICK_RATE;
+
+    publishWorld();
+    Clock::time_point nextTick = Clock::now();
+    while (simulationRunning.load(std::memory_order_acquire)) {
+        // Outside of play the world only changes through commands.
+        bool changed = processCommands();
+        if (simulating) {
+            step(deltaTime);
+            changed = true;
+        }
+        recordFrameTelemetry();
+        if (changed) {
+            publishWorld();
+        }
 
-    stats.timeElapsed += deltaTime;
-    
-    float speedMultiplier;
-    switch (difficulty) {
-        case Difficulty::EASY: speedMultiplier = 1.0f; break;
-        case Difficulty::MEDIUM: speedMultiplier = 1.5f; break;
-        case Difficulty::HARD: speedMultiplier = 2.0f; break;
+        if (!simulating) {
+            // Menus, pauses and game over have nothing to tick.
+            waitForCommand();
+            nextTick = Clock::now();
+            continue;
+        }
+
+        // Ticks run on a fixed schedule regardless of how long frames take.
+        // After a long stall, skip ahead rather than replaying missed ticks.
+        nextTick += tickLength;
+        Clock::time_point now = Clock::now();
+        if (now - nextTick > tickLength * 8) {
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
     }
-    
-    for (auto& enemy : enemies) {
-        enemy.update(deltaTime * speedMultiplier);
-        if (enemy.checkCollision(playerPos)) {
-            handleGameOver();
-            return;
+}
+
+void MazeGame::waitForCommand() {
+    // Announce the wait before the last look at the queue, so a command
+    // pushed in between is either seen here or wakes the wait below.
+    std::unique_lock<std::mutex> lock(simulationMutex);
+    simulationIdle.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (commands.empty()) {
+        simulationWake.wait(lock, [this]() {
+            return !simulationIdle.load() || !simulationRunning.load(std::memory_order_acquire);
+        });
+    }
+    simulationIdle.store(false);
+}
+
+bool MazeGame::processCommands() {
+    bool any = false;
+    Command command;
+    while (commands.tryPop(command)) {
+        any = true;
+        switch (command.type) {
+            case Command::Type::START_GAME:
+                session.setDifficulty(command.difficulty);
+                activeGeneration = command.generation;
+                startNewGame();
+                break;
+            case Command::Type::RESTART:
+                activeGeneration = command.generation;
+                startNewGame();
+                break;
+            case Command::Type::PAUSE:
+                simulating = false;
+                input.reset();
+                break;
+            case Command::Type::RESUME:
+                simulating = !gameOver;
+                break;
+            case Command::Type::KEY_PRESSED:
+                if (simulating) input.keyPressed(command.action, command.timestamp);
+                break;
+            case Command::Type::KEY_RELEASED:
+                input.keyReleased(command.action, command.timestamp);
+                break;
+            case Command::Type::RESET_INPUT:
+                input.reset();
+                break;
+            case Command::Type::REWIND_START:
+                rewinding = true;
+                input.reset();
+                break;
+            case Command::Type::REWIND_STOP:
+                rewinding = false;
+                break;
         }
     }
+    return any;
+}
 
-    for (auto& powerup : powerUps) {
-        powerup.update(deltaTime);
+void MazeGame::step(float deltaTime) {
+    if (rewinding) {
+        if (rewindBuffer.canRewind()) {
+            rewindBuffer.rewind(session, rewindBuffer.newestTick() - 1);
+        }
+        return;
     }
+
+    applyQueuedMoves();
+
+    if (session.update(deltaTime) == GameSession::StepResult::CAUGHT) {
+        const GameStats& stats = session.getStats();
+        telemetry.record(Telemetry::EventType::DEATH, stats.score, static_cast<int>(stats.timeElapsed * 1000.0f));
+        audio.play(AudioEngine::Cue::COLLISION);
+        finishGame();
+        return;
+    }
+    rewindBuffer.capture(session, ++simulationTick);
+}
+
+void MazeGame::publishWorld() {
+    if (!publishedMaze || publishedGridVersion != session.getGridVersion()) {
+        publishedMaze = std::make_shared<const std::vector<std::vector<char>>>(session.getMaze());
+        publishedGridVersion = session.getGridVersion();
+    }
+
+    WorldSnapshot& snapshot = world.writeSlot();
+    snapshot.generation = activeGeneration;
+    snapshot.tick = simulationTick;
+    snapshot.gridVersion = publishedGridVersion;
+    snapshot.maze = publishedMaze;
+    snapshot.playerPos = session.getPlayerPos();
+    snapshot.endPos = session.getEndPos();
+    snapshot.enemies.clear();
+    for (const auto& enemy : session.getEnemies()) {
+        snapshot.enemies.push_back(enemy.getPosition());
+    }
+    snapshot.powerUps = session.getPowerUps();
+    snapshot.stats = session.getStats();
+    snapshot.latency = input.getLatency();
+    snapshot.gameOver = gameOver;
+    world.publish();
+}
+
+void MazeGame::recordFrameTelemetry() {
+    // Every frame rendered since the last tick gets its own event; frames
+    // that found the queue full are reported on the next one.
+    FrameSample sample;
+    while (frameSamples.tryPop(sample)) {
+        std::uint32_t dropped = droppedFrameSamples.exchange(0, std::memory_order_relaxed);
+        telemetry.record(Telemetry::EventType::FRAME, sample.frameMicros, sample.jitterMicros,
+                         static_cast<std::int32_t>(dropped));
+    }
+}
+
+bool MazeGame::hasWorld() const {
+    // Until the simulation has picked up the latest start command, the
+    // front snapshot still shows the previous game.
+    const WorldSnapshot& snapshot = world.readSlot();
+    return snapshot.generation == gameGeneration && snapshot.maze && !snapshot.maze->empty();
 }
 
 void MazeGame::render() {
     window.clear(sf::Color(30, 30, 30));
+    world.update();
+    const WorldSnapshot& snapshot = world.readSlot();
+
+    if (state == GameState::PLAYING && hasWorld() && snapshot.gameOver) {
+        showGameOver(snapshot.stats);
+    }
 
-    if (state == GameState::PLAYING || state == GameState::PAUSED) {
+    if ((state == GameState::PLAYING || state == GameState::PAUSED) && hasWorld()) {
+        refreshMazeCanvas();
+        if (showSolution) {
+            refreshHintPath();
+        }
         window.setView(gameView);
         drawMaze();
         
-        for (const auto& powerup : powerUps) {
-            powerup.draw(window, cellSize);
+        for (const auto& powerup : snapshot.powerUps) {
+            if (!fogOfWar || fieldOfView.isVisible(powerup.position.x, powerup.position.y)) {
+                powerup.draw(window, cellSize);
+            }
         }
         
-        for (const auto& enemy : enemies) {
-            enemy.draw(window, cellSize);
+        for (const Point& position : snapshot.enemies) {
+            if (!fogOfWar || fieldOfView.isVisible(position.x, position.y)) {
+                Enemy::drawAt(window, position, cellSize);
+            }
         }
 
-        std::stringstream ss;
-        ss << "Score: " << stats.score << "\n"
-           << "Time: " << static_cast<int>(stats.timeElapsed) << "s\n"
-           << "Moves: " << stats.moveCount << "\n"
-           << "High Score: " << stats.highScore;
-        
-        if (state == GameState::PAUSED) {
-            ss << "\n\nPAUSED";
-        }
-        
-        statusText.setString(ss.str());
+        updateStatusText();
         window.draw(statusText);
 
         window.setView(minimapView);
@@ -286,39 +565,40 @@ void MazeGame::render() {
     window.display();
 }
 
+void MazeGame::updateStatusText() {
+    const WorldSnapshot& snapshot = world.readSlot();
+    const GameStats& stats = snapshot.stats;
+    const std::size_t capacity = 192;
+    char* buffer = frameArena.allocate<char>(capacity);
+    int length = std::snprintf(buffer, capacity, "Score: %d\nTime: %ds\nMoves: %d\nHigh Score: %d",
+                               stats.score, static_cast<int>(stats.timeElapsed), stats.moveCount,
+                               stats.highScore);
+    if (showMetrics && length > 0 && static_cast<std::size_t>(length) < capacity) {
+        const InputController::LatencyStats& latency = snapshot.latency;
+        const FramePacer::FrameStats& frames = pacer.getStats();
+        length += std::snprintf(buffer + length, capacity - length,
+                                "\nInput: %.1f ms avg, %.1f max\nFrame: %.2f ms, jitter %.2f",
+                                latency.averageMs, latency.maxMs, frames.averageMs, frames.jitterMs);
+    }
+    if (state == GameState::PAUSED && length > 0 && static_cast<std::size_t>(length) < capacity) {
+        std::snprintf(buffer + length, capacity - length, "\n\nPAUSED");
+    }
+
+    // sf::Text rebuilds its glyph geometry on every setString(), so only
+    // touch it when the visible text actually changed.
+    if (statusString.compare(buffer) != 0) {
+        statusString.assign(buffer);
+        statusText.setString(statusString);
+    }
+}
+
 void MazeGame::drawGameOver() {
-    sf::Text gameOverText;
-    gameOverText.setFont(ResourceManager::getInstance().getFont());
-    gameOverText.setString("Game Over!\nFinal Score: " + std::to_string(stats.score) + 
-                          "\nPress ESC to return to menu");
-    gameOverText.setCharacterSize(30);
-    gameOverText.setFillColor(sf::Color::White);
-    
-    sf::FloatRect textBounds = gameOverText.getLocalBounds();
-    gameOverText.setPosition(
-        (GameConstants::SCREEN_WIDTH - textBounds.width) / 2.f,
-        (GameConstants::SCREEN_HEIGHT - textBounds.height) / 2.f
-    );
-    
     window.draw(gameOverText);
 }
 
 void MazeGame::drawDifficultyMenu() {
     window.clear(sf::Color(30, 30, 30));
-
-    sf::Text title;
-    title.setFont(ResourceManager::getInstance().getFont());
-    title.setString("Select Difficulty");
-    title.setCharacterSize(40);
-    title.setFillColor(sf::Color::White);
-    
-    sf::FloatRect titleBounds = title.getLocalBounds();
-    title.setPosition(
-        (GameConstants::SCREEN_WIDTH - titleBounds.width) / 2.f,
-        GameConstants::SCREEN_HEIGHT * 0.15f
-    );
-
-    window.draw(title);
+    window.draw(titleText);
 
     for (const auto& button : buttons) {
         button->draw(window);
@@ -327,186 +607,126 @@ void MazeGame::drawDifficultyMenu() {
     window.display();
 }
 
-void MazeGame::drawMaze() {
-    sf::RectangleShape cell(sf::Vector2f(cellSize, cellSize));
-
-    for (size_t y = 0; y < maze.size(); ++y) {
-        for (size_t x = 0; x < maze[y].size(); ++x) {
-            cell.setPosition(x * cellSize, y * cellSize);
-            
-            if (Point(x, y) == playerPos) {
-                cell.setFillColor(sf::Color::Cyan);
-            }
-            else if (Point(x, y) == endPos) {
-                cell.setFillColor(sf::Color::Green);
-            }
-            else if (maze[y][x] == '#') {
-                cell.setFillColor(sf::Color(50, 50, 50));
-            }
-            else {
-                cell.setFillColor(sf::Color(200, 200, 200));
-            }
-
-            window.draw(cell);
+void MazeGame::refreshHintPath() {
+    const WorldSnapshot& snapshot = world.readSlot();
+    const auto& maze = *snapshot.maze;
+    const bool large = !maze.empty() && maze.size() * maze[0].size() >= static_cast<std::size_t>(GameConstants::HPA_MIN_CELLS);
+    if (pathfinderGridVersion != snapshot.gridVersion) {
+        if (large) {
+            largePathfinder.build(maze);
+        } else {
+            pathfinder.build(maze, {snapshot.endPos});
         }
+        pathfinderGridVersion = snapshot.gridVersion;
+    } else if (hintOrigin == snapshot.playerPos && !hintPath.empty()) {
+        return;
+    }
+    hintOrigin = snapshot.playerPos;
+    if (large) {
+        largePathfinder.findPath(snapshot.playerPos, snapshot.endPos, hintPath);
+    } else {
+        pathfinder.findPath(snapshot.playerPos, snapshot.endPos, hintPath);
     }
 }
 
-void MazeGame::generateMaze() {
-    int width, height;
-    switch (difficulty) {
-        case Difficulty::EASY:
-            width = height = 15;
-            break;
-        case Difficulty::MEDIUM:
-            width = height = 21;
-            break;
-        case Difficulty::HARD:
-            width = height = 31;
-            break;
+void MazeGame::refreshMazeCanvas() {
+    const WorldSnapshot& snapshot = world.readSlot();
+    const auto& maze = *snapshot.maze;
+    const Point& playerPos = snapshot.playerPos;
+    const int height = static_cast<int>(maze.size());
+    const int width = height > 0 ? static_cast<int>(maze[0].size()) : 0;
+
+    bool rebuild = canvasStale || canvasGridVersion != snapshot.gridVersion;
+    if (rebuild) {
+        mazeCanvas.resize(width, height);
+        fieldOfView.reset(width, height);
+        canvasGridVersion = snapshot.gridVersion;
+        canvasStale = false;
     }
-    
-    maze = std::vector<std::vector<char>>(height, std::vector<char>(width, '#'));
-    
-    playerPos = Point(1, 1);
-    endPos = Point(width - 2, height - 2);
-    
-    std::vector<std::vector<bool>> visited(height, std::vector<bool>(width, false));
-    std::stack<Point> stack;
-    Point current = playerPos;
-    
-    while (current != endPos) {
-        visited[current.y][current.x] = true;
-        maze[current.y][current.x] = ' ';
-        
-        std::vector<Point> neighbors;
-        std::vector<Point> directions = {
-            Point(0, -2), // Up
-            Point(0, 2),  // Down
-            Point(-2, 0), // Left
-            Point(2, 0)   // Right
-        };
-        
-        for (const auto& dir : directions) {
-            Point next(current.x + dir.x, current.y + dir.y);
-            if (next.x > 0 && next.x < width - 1 && 
-                next.y > 0 && next.y < height - 1 && 
-                !visited[next.y][next.x]) {
-                neighbors.push_back(next);
+
+    // Visibility only changes when the player moves to another cell.
+    if (fogOfWar && (rebuild || playerPos != visibilityOrigin)) {
+        fieldOfView.update(maze, playerPos, GameConstants::FOG_VIEW_RADIUS);
+        visibilityOrigin = playerPos;
+        if (!rebuild) {
+            for (const Point& cell : fieldOfView.getChangedCells()) {
+                mazeCanvas.setCell(cell.x, cell.y, cellColor(cell.x, cell.y));
             }
         }
-        
-        if (!neighbors.empty()) {
-            int idx = std::rand() % neighbors.size();
-            Point next = neighbors[idx];
-            maze[(current.y + next.y) / 2][(current.x + next.x) / 2] = ' ';
-            stack.push(current);
-            current = next;
-        } else if (!stack.empty()) {
-            current = stack.top();
-            stack.pop();
-        } else {
-            break;
-        }
-    }
-    
-    maze[playerPos.y][playerPos.x] = ' ';
-    maze[endPos.y][endPos.x] = ' ';
-    
-    int pathCount;
-    switch (difficulty) {
-        case Difficulty::EASY:
-            pathCount = width * height / 8;  // More paths = easier
-            break;
-        case Difficulty::MEDIUM:
-            pathCount = width * height / 10;
-            break;
-        case Difficulty::HARD:
-            pathCount = width * height / 15; // Fewer paths = harder
-            break;
     }
-    
-    for (int i = 0; i < pathCount; i++) {
-        int x = 1 + std::rand() % (width - 2);
-        int y = 1 + std::rand() % (height - 2);
-        if (Point(x, y) != playerPos && Point(x, y) != endPos) {
-            maze[y][x] = ' ';
+
+    if (rebuild) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                mazeCanvas.setCell(x, y, cellColor(x, y));
+            }
         }
     }
 
-    enemies.clear();
-    int enemyCount;
-    float enemySpeed;
-    switch (difficulty) {
-        case Difficulty::EASY:
-            enemyCount = 2;
-            enemySpeed = 1.0f;
-            break;
-        case Difficulty::MEDIUM:
-            enemyCount = 4;
-            enemySpeed = 1.5f;
-            break;
-        case Difficulty::HARD:
-            enemyCount = 6;
-            enemySpeed = 2.0f;
-            break;
+    mazeCanvas.flush(frameArena);
+}
+
+sf::Color MazeGame::cellColor(int x, int y) const {
+    const WorldSnapshot& snapshot = world.readSlot();
+    sf::Color color;
+    if (Point(x, y) == snapshot.endPos) {
+        color = sf::Color::Green;
+    }
+    else if ((*snapshot.maze)[y][x] == '#') {
+        color = sf::Color(50, 50, 50);
+    }
+    else {
+        color = sf::Color(200, 200, 200);
     }
 
-    for (int i = 0; i < enemyCount; i++) {
-        Point pos;
-        do {
-            pos.x = 1 + std::rand() % (width - 2);
-            pos.y = 1 + std::rand() % (height - 2);
-        } while (pos == playerPos || pos == endPos || maze[pos.y][pos.x] != ' ');
-        
-        enemies.emplace_back(pos, enemySpeed);
+    if (!fogOfWar || fieldOfView.isVisible(x, y)) {
+        return color;
+    }
+    if (fieldOfView.isExplored(x, y)) {
+        return sf::Color(color.r * 2 / 5, color.g * 2 / 5, color.b * 2 / 5);
     }
+    return sf::Color(15, 15, 15);
 }
 
-void MazeGame::updateScore() {
-    float multiplier;
-    switch (difficulty) {
-        case Difficulty::EASY:
-            multiplier = 1.0f;
-            break;
-        case Difficulty::MEDIUM:
-            multiplier = 1.5f;
-            break;
-        case Difficulty::HARD:
-            multiplier = 2.0f;
-            break;
-    }
-    
-    int mazeScore = static_cast<int>(1000 * multiplier);
-    mazeScore -= static_cast<int>(stats.timeElapsed * (10 * multiplier));
-    mazeScore -= static_cast<int>(stats.moveCount * (5 * multiplier));
-    
-    if (mazeScore < 0) mazeScore = 0;
-    stats.score += mazeScore;
-    
-    if (stats.score > stats.highScore) {
-        stats.highScore = stats.score;
-        saveHighScore();
+void MazeGame::drawMaze() {
+    mazeCanvas.draw(window, cellSize);
+
+    if (showSolution) {
+        float markerSize = cellSize / 3.f;
+        cellShape.setSize(sf::Vector2f(markerSize, markerSize));
+        cellShape.setFillColor(sf::Color(255, 215, 0, 160));
+        for (const Point& cell : hintPath) {
+            cellShape.setPosition(cell.x * cellSize + markerSize, cell.y * cellSize + markerSize);
+            window.draw(cellShape);
+        }
     }
+
+    const Point& playerPos = world.readSlot().playerPos;
+    cellShape.setSize(sf::Vector2f(cellSize, cellSize));
+    cellShape.setPosition(playerPos.x * cellSize, playerPos.y * cellSize);
+    cellShape.setFillColor(sf::Color::Cyan);
+    window.draw(cellShape);
 }
 
-void MazeGame::handleGameOver() {
+void MazeGame::finishGame() {
+    input.reset();
+    GameStats& stats = session.getStats();
     if (stats.score > stats.highScore) {
         stats.highScore = stats.score;
         saveHighScore();
     }
-    state = GameState::GAME_OVER;
+    simulating = false;
+    rewinding = false;
+    gameOver = true;
 }
 
-bool MazeGame::isValidMove(const Point& pos) const {
-    if (pos.x < 0 || pos.x >= static_cast<int>(maze[0].size()) ||
-        pos.y < 0 || pos.y >= static_cast<int>(maze.size())) {
-        return false;
-    }
-    return maze[pos.y][pos.x] == ' ';
+void MazeGame::showGameOver(const GameStats& stats) {
+    gameOverText.setString("Game Over!\nFinal Score: " + std::to_string(stats.score) + 
+                           "\nPress ESC to return to menu");
+    sf::FloatRect textBounds = gameOverText.getLocalBounds();
+    gameOverText.setPosition(
+        (GameConstants::SCREEN_WIDTH - textBounds.width) / 2.f,
+        (GameConstants::SCREEN_HEIGHT - textBounds.height) / 2.f
+    );
+    state = GameState::GAME_OVER;
 }
-
-void MazeGame::movePlayer(const Point& newPos) {
-    playerPos = newPos;
-    stats.moveCount++;
-}
\ No newline at end of file
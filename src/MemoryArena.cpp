@@ -0,0 +1,36 @@
+// MemoryArena.cpp
+#include "MemoryArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+LinearArena::LinearArena(std::size_t capacity)
+    : buffer(capacity ? new unsigned char[capacity] : nullptr)
+    , capacity(capacity)
+    , offset(0)
+    , used(0) {}
+
+void* LinearArena::allocateBytes(std::size_t size, std::size_t alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    std::size_t aligned = (base + offset + alignment - 1) / alignment * alignment - base;
+    used += size + alignment - 1;
+
+    if (buffer && aligned + size <= capacity) {
+        offset = aligned + size;
+        return buffer.get() + aligned;
+    }
+
+    // Out of space for this cycle: satisfy the request from the heap.
+    overflow.emplace_back(new unsigned char[size + alignment]);
+    std::uintptr_t block = reinterpret_cast<std::uintptr_t>(overflow.back().get());
+    return reinterpret_cast<void*>((block + alignment - 1) / alignment * alignment);
+}
+
+void LinearArena::reset() {
+    if (!overflow.empty()) {
+        overflow.clear();
+        capacity = std::max(used, capacity * 2);
+        buffer.reset(new unsigned char[capacity]);
+    }
+    offset = 0;
+    used = 0;
+}
@@ -0,0 +1,378 @@
+// NetProtocol.cpp
+#include "NetProtocol.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace {
+    enum SnapshotFlags : std::uint8_t {
+        GRID_CHANGED = 1 << 0,
+        PLAYER_CHANGED = 1 << 1,
+        END_CHANGED = 1 << 2,
+        STATS_CHANGED = 1 << 3,
+        ENEMIES_CHANGED = 1 << 4
+    };
+
+    class ByteWriter {
+    public:
+        explicit ByteWriter(std::vector<std::uint8_t>& out) : out(out) {}
+
+        void u8(std::uint8_t value) { out.push_back(value); }
+        void u16(std::uint16_t value) {
+            out.push_back(static_cast<std::uint8_t>(value));
+            out.push_back(static_cast<std::uint8_t>(value >> 8));
+        }
+        void u32(std::uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+        void bytes(const std::uint8_t* data, std::size_t size) { out.insert(out.end(), data, data + size); }
+
+        // Reserves the frame header; finish() patches the length in.
+        std::size_t begin(NetProtocol::MessageType type) {
+            std::size_t start = out.size();
+            u32(0);
+            u8(static_cast<std::uint8_t>(type));
+            return start;
+        }
+        void finish(std::size_t start) {
+            std::uint32_t length = static_cast<std::uint32_t>(out.size() - start - 4);
+            for (int i = 0; i < 4; ++i) {
+                out[start + i] = static_cast<std::uint8_t>(length >> (8 * i));
+            }
+        }
+
+    private:
+        std::vector<std::uint8_t>& out;
+    };
+
+    class ByteReader {
+    public:
+        ByteReader(const std::uint8_t* data, std::size_t size) : data(data), size(size), pos(0), failed(false) {}
+
+        std::uint8_t u8() {
+            if (!require(1)) return 0;
+            return data[pos++];
+        }
+        std::uint16_t u16() {
+            if (!require(2)) return 0;
+            std::uint16_t value = static_cast<std::uint16_t>(data[pos] | (data[pos + 1] << 8));
+            pos += 2;
+            return value;
+        }
+        std::uint32_t u32() {
+            if (!require(4)) return 0;
+            std::uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value |= static_cast<std::uint32_t>(data[pos + i]) << (8 * i);
+            }
+            pos += 4;
+            return value;
+        }
+        void bytes(std::uint8_t* dest, std::size_t count) {
+            if (!require(count)) return;
+            std::memcpy(dest, data + pos, count);
+            pos += count;
+        }
+        bool ok() const { return !failed; }
+
+    private:
+        bool require(std::size_t count) {
+            if (failed || size - pos < count) {
+                failed = true;
+                return false;
+            }
+            return true;
+        }
+
+        const std::uint8_t* data;
+        std::size_t size;
+        std::size_t pos;
+        bool failed;
+    };
+
+    std::shared_ptr<const NetProtocol::ChunkGrid> packGrid(const std::vector<std::vector<char>>& maze,
+                                                           int chunksX, int chunksY) {
+        auto grid = std::make_shared<NetProtocol::ChunkGrid>(chunksX * chunksY);
+        for (auto& chunk : *grid) {
+            chunk.fill(0);
+        }
+        for (size_t y = 0; y < maze.size(); ++y) {
+            for (size_t x = 0; x < maze[y].size(); ++x) {
+                if (maze[y][x] != '#') continue;
+                auto& chunk = (*grid)[(y / NetProtocol::CHUNK_SIZE) * chunksX + x / NetProtocol::CHUNK_SIZE];
+                int bit = static_cast<int>((y % NetProtocol::CHUNK_SIZE) * NetProtocol::CHUNK_SIZE +
+                                           x % NetProtocol::CHUNK_SIZE);
+                chunk[bit / 8] |= static_cast<std::uint8_t>(1 << (bit % 8));
+            }
+        }
+        return grid;
+    }
+}
+
+namespace NetProtocol {
+
+bool Snapshot::isWall(int x, int y) const {
+    if (!chunks || x < 0 || y < 0 || x >= width || y >= height) return true;
+    const Chunk& chunk = (*chunks)[(y / CHUNK_SIZE) * chunksX() + x / CHUNK_SIZE];
+    int bit = (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE;
+    return (chunk[bit / 8] >> (bit % 8)) & 1;
+}
+
+Snapshot capture(const GameSession& session, std::uint32_t id, std::uint32_t tick, const Snapshot* previous) {
+    const auto& maze = session.getMaze();
+
+    Snapshot snapshot;
+    snapshot.id = id;
+    snapshot.tick = tick;
+    snapshot.height = static_cast<std::uint16_t>(maze.size());
+    snapshot.width = static_cast<std::uint16_t>(maze.empty() ? 0 : maze[0].size());
+    snapshot.gridVersion = session.getGridVersion();
+    if (previous && previous->chunks && previous->gridVersion == snapshot.gridVersion) {
+        snapshot.chunks = previous->chunks;
+    } else {
+        snapshot.chunks = packGrid(maze, snapshot.chunksX(), snapshot.chunksY());
+    }
+
+    snapshot.player = session.getPlayerPos();
+    snapshot.end = session.getEndPos();
+
+    const auto& enemies = session.getEnemies();
+    snapshot.enemies.reserve(enemies.size());
+    for (const auto& enemy : enemies) {
+        snapshot.enemies.push_back({
+            static_cast<std::int16_t>(enemy.getPosition().x),
+            static_cast<std::int16_t>(enemy.getPosition().y),
+            static_cast<std::uint16_t>(std::lround(enemy.getSpeed() * 100.0f))
+        });
+    }
+
+    const auto& stats = session.getStats();
+    snapshot.stats.score = stats.score;
+    snapshot.stats.moveCount = stats.moveCount;
+    snapshot.stats.timeElapsedMs = static_cast<std::uint32_t>(stats.timeElapsed * 1000.0f);
+    snapshot.stats.highScore = stats.highScore;
+    snapshot.stats.powerUpsCollected = stats.powerUpsCollected;
+    return snapshot;
+}
+
+void writeSnapshot(const Snapshot& current, const Snapshot* base, std::vector<std::uint8_t>& out) {
+    ByteWriter writer(out);
+    std::size_t frame = writer.begin(MessageType::SNAPSHOT);
+
+    bool full = base == nullptr;
+    bool sameShape = !full && base->width == current.width && base->height == current.height;
+
+    std::uint8_t flags = 0;
+    if (!sameShape || base->gridVersion != current.gridVersion) flags |= GRID_CHANGED;
+    if (full || base->player != current.player) flags |= PLAYER_CHANGED;
+    if (full || base->end != current.end) flags |= END_CHANGED;
+    if (full || std::memcmp(&base->stats, &current.stats, sizeof(StatsState)) != 0) flags |= STATS_CHANGED;
+    if (full || base->enemies != current.enemies) flags |= ENEMIES_CHANGED;
+
+    writer.u32(current.id);
+    writer.u32(full ? 0 : base->id);
+    writer.u32(current.tick);
+    writer.u8(flags);
+
+    if (flags & GRID_CHANGED) {
+        writer.u16(current.width);
+        writer.u16(current.height);
+        writer.u32(current.gridVersion);
+
+        std::vector<std::uint16_t> changed;
+        for (std::size_t i = 0; i < current.chunks->size(); ++i) {
+            if (!sameShape || !base->chunks || (*base->chunks)[i] != (*current.chunks)[i]) {
+                changed.push_back(static_cast<std::uint16_t>(i));
+            }
+        }
+        writer.u16(static_cast<std::uint16_t>(changed.size()));
+        for (std::uint16_t index : changed) {
+            writer.u16(index);
+            writer.bytes((*current.chunks)[index].data(), CHUNK_BYTES);
+        }
+    }
+
+    if (flags & PLAYER_CHANGED) {
+        writer.u16(static_cast<std::uint16_t>(current.player.x));
+        writer.u16(static_cast<std::uint16_t>(current.player.y));
+    }
+    if (flags & END_CHANGED) {
+        writer.u16(static_cast<std::uint16_t>(current.end.x));
+        writer.u16(static_cast<std::uint16_t>(current.end.y));
+    }
+
+    if (flags & STATS_CHANGED) {
+        const StatsState& now = current.stats;
+        StatsState before = full ? StatsState{} : base->stats;
+        std::uint32_t fields[] = {
+            static_cast<std::uint32_t>(now.score), static_cast<std::uint32_t>(now.moveCount),
+            now.timeElapsedMs, static_cast<std::uint32_t>(now.highScore),
+            static_cast<std::uint32_t>(now.powerUpsCollected)
+        };
+        std::uint32_t baseFields[] = {
+            static_cast<std::uint32_t>(before.score), static_cast<std::uint32_t>(before.moveCount),
+            before.timeElapsedMs, static_cast<std::uint32_t>(before.highScore),
+            static_cast<std::uint32_t>(before.powerUpsCollected)
+        };
+        std::uint8_t mask = 0;
+        std::vector<std::uint32_t> values;
+        for (int i = 0; i < 5; ++i) {
+            if (full || fields[i] != baseFields[i]) {
+                mask |= static_cast<std::uint8_t>(1 << i);
+                values.push_back(fields[i]);
+            }
+        }
+        writer.u8(mask);
+        for (std::uint32_t value : values) {
+            writer.u32(value);
+        }
+    }
+
+    if (flags & ENEMIES_CHANGED) {
+        std::vector<std::uint16_t> changed;
+        for (std::size_t i = 0; i < current.enemies.size(); ++i) {
+            if (full || i >= base->enemies.size() || base->enemies[i] != current.enemies[i]) {
+                changed.push_back(static_cast<std::uint16_t>(i));
+            }
+        }
+        writer.u16(static_cast<std::uint16_t>(current.enemies.size()));
+        writer.u16(static_cast<std::uint16_t>(changed.size()));
+        for (std::uint16_t index : changed) {
+            const EnemyState& enemy = current.enemies[index];
+            writer.u16(index);
+            writer.u16(static_cast<std::uint16_t>(enemy.x));
+            writer.u16(static_cast<std::uint16_t>(enemy.y));
+            writer.u16(enemy.speedCenti);
+        }
+    }
+
+    writer.finish(frame);
+}
+
+bool peekBaseId(const std::uint8_t* data, std::size_t size, std::uint32_t& baseId) {
+    ByteReader reader(data, size);
+    reader.u32();
+    baseId = reader.u32();
+    return reader.ok();
+}
+
+bool readSnapshot(const std::uint8_t* data, std::size_t size, const Snapshot* base, Snapshot& out) {
+    ByteReader reader(data, size);
+
+    out = base ? *base : Snapshot();
+    out.id = reader.u32();
+    std::uint32_t baseId = reader.u32();
+    out.tick = reader.u32();
+    std::uint8_t flags = reader.u8();
+    if (!reader.ok() || (baseId != 0 && (!base || base->id != baseId))) {
+        return false;
+    }
+
+    if (flags & GRID_CHANGED) {
+        out.width = reader.u16();
+        out.height = reader.u16();
+        out.gridVersion = reader.u32();
+
+        std::size_t chunkCount = static_cast<std::size_t>(out.chunksX()) * out.chunksY();
+        std::shared_ptr<ChunkGrid> grid;
+        if (base && base->chunks && base->chunks->size() == chunkCount) {
+            grid = std::make_shared<ChunkGrid>(*base->chunks);
+        } else {
+            grid = std::make_shared<ChunkGrid>(chunkCount, Chunk{});
+        }
+
+        std::uint16_t changed = reader.u16();
+        for (std::uint16_t i = 0; i < changed && reader.ok(); ++i) {
+            std::uint16_t index = reader.u16();
+            if (index >= chunkCount) return false;
+            reader.bytes((*grid)[index].data(), CHUNK_BYTES);
+        }
+        out.chunks = grid;
+    }
+
+    if (flags & PLAYER_CHANGED) {
+        out.player.x = static_cast<std::int16_t>(reader.u16());
+        out.player.y = static_cast<std::int16_t>(reader.u16());
+    }
+    if (flags & END_CHANGED) {
+        out.end.x = static_cast<std::int16_t>(reader.u16());
+        out.end.y = static_cast<std::int16_t>(reader.u16());
+    }
+
+    if (flags & STATS_CHANGED) {
+        std::uint8_t mask = reader.u8();
+        std::uint32_t fields[] = {
+            static_cast<std::uint32_t>(out.stats.score), static_cast<std::uint32_t>(out.stats.moveCount),
+            out.stats.timeElapsedMs, static_cast<std::uint32_t>(out.stats.highScore),
+            static_cast<std::uint32_t>(out.stats.powerUpsCollected)
+        };
+        for (int i = 0; i < 5; ++i) {
+            if (mask & (1 << i)) fields[i] = reader.u32();
+        }
+        out.stats.score = static_cast<std::int32_t>(fields[0]);
+        out.stats.moveCount = static_cast<std::int32_t>(fields[1]);
+        out.stats.timeElapsedMs = fields[2];
+        out.stats.highScore = static_cast<std::int32_t>(fields[3]);
+        out.stats.powerUpsCollected = static_cast<std::int32_t>(fields[4]);
+    }
+
+    if (flags & ENEMIES_CHANGED) {
+        std::uint16_t count = reader.u16();
+        out.enemies.resize(count);
+        std::uint16_t changed = reader.u16();
+        for (std::uint16_t i = 0; i < changed && reader.ok(); ++i) {
+            std::uint16_t index = reader.u16();
+            if (index >= count) return false;
+            EnemyState& enemy = out.enemies[index];
+            enemy.x = static_cast<std::int16_t>(reader.u16());
+            enemy.y = static_cast<std::int16_t>(reader.u16());
+            enemy.speedCenti = reader.u16();
+        }
+    }
+
+    return reader.ok();
+}
+
+void writeHello(GameSession::Difficulty difficulty, std::vector<std::uint8_t>& out) {
+    ByteWriter writer(out);
+    std::size_t frame = writer.begin(MessageType::HELLO);
+    writer.u8(static_cast<std::uint8_t>(difficulty));
+    writer.finish(frame);
+}
+
+void writeInput(const std::vector<GameSession::Action>& actions, std::vector<std::uint8_t>& out) {
+    ByteWriter writer(out);
+    std::size_t frame = writer.begin(MessageType::INPUT);
+    std::size_t count = actions.size() > 255 ? 255 : actions.size();
+    writer.u8(static_cast<std::uint8_t>(count));
+    for (std::size_t i = 0; i < count; ++i) {
+        writer.u8(static_cast<std::uint8_t>(actions[i]));
+    }
+    writer.finish(frame);
+}
+
+void writeAck(std::uint32_t snapshotId, std::vector<std::uint8_t>& out) {
+    ByteWriter writer(out);
+    std::size_t frame = writer.begin(MessageType::ACK);
+    writer.u32(snapshotId);
+    writer.finish(frame);
+}
+
+FrameStatus nextFrame(const std::vector<std::uint8_t>& buffer, std::size_t offset, MessageType& type,
+                      const std::uint8_t*& payload, std::size_t& payloadSize, std::size_t& consumed) {
+    if (buffer.size() - offset < 5) return FrameStatus::INCOMPLETE;
+
+    ByteReader reader(buffer.data() + offset, 4);
+    std::uint32_t length = reader.u32();
+    if (length == 0 || length > MAX_MESSAGE_SIZE) return FrameStatus::MALFORMED;
+    if (buffer.size() - offset - 4 < length) return FrameStatus::INCOMPLETE;
+
+    type = static_cast<MessageType>(buffer[offset + 4]);
+    payload = buffer.data() + offset + 5;
+    payloadSize = length - 1;
+    consumed = length + 4;
+    return FrameStatus::READY;
+}
+
+}
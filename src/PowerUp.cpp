@@ -17,7 +17,12 @@ void PowerUp::update(float deltaTime) {
 void PowerUp::draw(sf::RenderWindow& window, float cellSize) const {
     if (!active) return;
 
-    sf::CircleShape shape(cellSize / 3.f);
+    // Shared across power-ups; setRadius() rebuilds the outline, so only
+    // call it when the cell size changes.
+    static sf::CircleShape shape;
+    if (shape.getRadius() != cellSize / 3.f) {
+        shape.setRadius(cellSize / 3.f);
+    }
     shape.setPosition(position.x * cellSize + cellSize / 3.f,
                      position.y * cellSize + cellSize / 3.f);
     
@@ -0,0 +1,242 @@
+// RewindBuffer.cpp
+#include "RewindBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+RewindBuffer::RewindBuffer(std::size_t capacityTicks)
+    : records(std::max<std::size_t>(capacityTicks, 2))
+    , head(0)
+    , count(0)
+    , liveGridVersion(0)
+    , lastKeyframeTick(0) {
+}
+
+void RewindBuffer::clear() {
+    for (auto& record : records) {
+        record.grid.reset();
+        record.epoch.reset();
+    }
+    head = 0;
+    count = 0;
+    liveGrid.reset();
+    liveEpoch.reset();
+    lastEnemyIndices.clear();
+    lastPowerUps.clear();
+}
+
+std::uint32_t RewindBuffer::oldestTick() const {
+    // Records before the first keyframe have lost their base and cannot be
+    // reconstructed.
+    for (std::size_t position = 0; position < count; ++position) {
+        if (at(position).keyframe) {
+            return at(position).tick;
+        }
+    }
+    return newestTick();
+}
+
+std::uint32_t RewindBuffer::newestTick() const {
+    return count > 0 ? at(count - 1).tick : 0;
+}
+
+std::shared_ptr<const RewindBuffer::GridTable> RewindBuffer::buildTable(const GameSession& session) const {
+    const auto& maze = session.maze;
+    auto table = std::make_shared<GridTable>();
+    table->height = static_cast<int>(maze.size());
+    table->width = maze.empty() ? 0 : static_cast<int>(maze[0].size());
+    table->chunksX = (table->width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int chunksY = (table->height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    table->chunks.reserve(static_cast<std::size_t>(table->chunksX) * chunksY);
+
+    // Chunks are only comparable against a table with the same layout.
+    const GridTable* previous = liveGrid.get();
+    if (previous && (previous->width != table->width || previous->height != table->height)) {
+        previous = nullptr;
+    }
+
+    GridChunk chunk;
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < table->chunksX; ++cx) {
+            chunk.fill('#');
+            int x0 = cx * CHUNK_SIZE;
+            int columns = std::min(CHUNK_SIZE, table->width - x0);
+            for (int row = 0; row < CHUNK_SIZE && cy * CHUNK_SIZE + row < table->height; ++row) {
+                std::memcpy(&chunk[row * CHUNK_SIZE], &maze[cy * CHUNK_SIZE + row][x0], columns);
+            }
+
+            std::size_t index = table->chunks.size();
+            if (previous && *previous->chunks[index] == chunk) {
+                table->chunks.push_back(previous->chunks[index]);
+            } else {
+                table->chunks.push_back(std::make_shared<const GridChunk>(chunk));
+            }
+        }
+    }
+    return table;
+}
+
+void RewindBuffer::capture(const GameSession& session, std::uint32_t tick) {
+    bool newMaze = !liveEpoch || session.gridVersion != liveGridVersion;
+    if (newMaze) {
+        liveGrid = buildTable(session);
+        auto epoch = std::make_shared<Epoch>();
+        epoch->enemies = session.enemies;
+        epoch->powerUps = session.powerUps;
+        liveEpoch = epoch;
+        liveGridVersion = session.gridVersion;
+    }
+
+    std::size_t position;
+    if (count < records.size()) {
+        position = count++;
+    } else {
+        head = (head + 1) % records.size();
+        position = count - 1;
+    }
+
+    TickRecord& record = at(position);
+    record.tick = tick;
+    record.keyframe = newMaze || position == 0 || tick - lastKeyframeTick >= KEYFRAME_INTERVAL;
+    record.grid = liveGrid;
+    record.epoch = liveEpoch;
+    record.difficulty = session.difficulty;
+    record.stats = session.stats;
+    record.playerPos = session.playerPos;
+    record.endPos = session.endPos;
+    if (record.keyframe) {
+        lastKeyframeTick = tick;
+    }
+
+    // Vectors keep their capacity as slots are reused, so steady-state
+    // capture does not allocate.
+    record.enemies.clear();
+    lastEnemyIndices.resize(session.enemies.size());
+    for (std::size_t i = 0; i < session.enemies.size(); ++i) {
+        float pathIndex = session.enemies[i].getPathIndex();
+        if (record.keyframe || lastEnemyIndices[i] != pathIndex) {
+            record.enemies.push_back({static_cast<std::uint16_t>(i), pathIndex});
+            lastEnemyIndices[i] = pathIndex;
+        }
+    }
+
+    record.powerUps.clear();
+    lastPowerUps.resize(session.powerUps.size());
+    for (std::size_t i = 0; i < session.powerUps.size(); ++i) {
+        const PowerUp& powerUp = session.powerUps[i];
+        PowerUpDelta& last = lastPowerUps[i];
+        if (record.keyframe || last.active != powerUp.active || last.duration != powerUp.duration) {
+            last = {static_cast<std::uint16_t>(i), powerUp.active, powerUp.duration};
+            record.powerUps.push_back(last);
+        }
+    }
+}
+
+const RewindBuffer::TickRecord* RewindBuffer::findRecord(std::uint32_t tick, std::size_t& position) const {
+    // Latest record at or before `tick`; ticks increase monotonically.
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        std::size_t mid = (low + high) / 2;
+        if (at(mid).tick <= tick) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == 0) {
+        return nullptr;
+    }
+    position = low - 1;
+    return &at(position);
+}
+
+void RewindBuffer::restoreGrid(GameSession& session, const GridTable& target) {
+    auto& maze = session.maze;
+    bool incremental = liveGrid && session.gridVersion == liveGridVersion &&
+                       liveGrid->width == target.width && liveGrid->height == target.height;
+    if (!incremental) {
+        maze.resize(target.height);
+        for (auto& row : maze) {
+            row.resize(target.width);
+        }
+    }
+
+    for (std::size_t index = 0; index < target.chunks.size(); ++index) {
+        if (incremental && liveGrid->chunks[index] == target.chunks[index]) {
+            continue;
+        }
+        const GridChunk& chunk = *target.chunks[index];
+        int x0 = static_cast<int>(index % target.chunksX) * CHUNK_SIZE;
+        int y0 = static_cast<int>(index / target.chunksX) * CHUNK_SIZE;
+        int columns = std::min(CHUNK_SIZE, target.width - x0);
+        for (int row = 0; row < CHUNK_SIZE && y0 + row < target.height; ++row) {
+            std::memcpy(&maze[y0 + row][x0], &chunk[row * CHUNK_SIZE], columns);
+        }
+    }
+}
+
+bool RewindBuffer::rewind(GameSession& session, std::uint32_t tick) {
+    std::size_t position = 0;
+    const TickRecord* target = findRecord(tick, position);
+    if (!target) {
+        return false;
+    }
+
+    std::size_t keyframe = position;
+    while (!at(keyframe).keyframe) {
+        if (keyframe == 0) {
+            return false;
+        }
+        --keyframe;
+    }
+
+    if (target->grid != liveGrid || session.gridVersion != liveGridVersion) {
+        restoreGrid(session, *target->grid);
+        // A fresh version makes renderers and snapshot caches rebuild instead
+        // of matching a version number that now names different contents.
+        ++session.gridVersion;
+    }
+
+    if (target->epoch != liveEpoch || session.enemies.size() != target->epoch->enemies.size()) {
+        session.enemies = target->epoch->enemies;
+        session.powerUps = target->epoch->powerUps;
+    }
+    for (std::size_t i = keyframe; i <= position; ++i) {
+        const TickRecord& record = at(i);
+        for (const auto& delta : record.enemies) {
+            session.enemies[delta.index].setPathIndex(delta.pathIndex);
+        }
+        for (const auto& delta : record.powerUps) {
+            session.powerUps[delta.index].active = delta.active;
+            session.powerUps[delta.index].duration = delta.duration;
+        }
+    }
+
+    int highScore = session.stats.highScore;
+    session.difficulty = target->difficulty;
+    session.stats = target->stats;
+    session.stats.highScore = std::max(highScore, target->stats.highScore);
+    session.playerPos = target->playerPos;
+    session.endPos = target->endPos;
+
+    // The restored tick becomes the newest record.
+    for (std::size_t i = position + 1; i < count; ++i) {
+        at(i).grid.reset();
+        at(i).epoch.reset();
+    }
+    count = position + 1;
+    liveGrid = target->grid;
+    liveEpoch = target->epoch;
+    liveGridVersion = session.gridVersion;
+    lastKeyframeTick = at(keyframe).tick;
+
+    lastEnemyIndices.resize(session.enemies.size());
+    for (std::size_t i = 0; i < session.enemies.size(); ++i) {
+        lastEnemyIndices[i] = session.enemies[i].getPathIndex();
+    }
+    lastPowerUps.resize(session.powerUps.size());
+    for (std::size_t i = 0; i < session.powerUps.size(); ++i) {
+        lastPowerUps[i] = {static_cast<std::uint16_t>(i), session.powerUps[i].active, session.powerUps[i].duration};
+    }
+    return true;
+}
@@ -0,0 +1,180 @@
+// Telemetry.cpp
+#include "Telemetry.hpp"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace {
+    const char MAGIC[4] = {'M', 'Z', 'T', 'L'};
+    const std::uint8_t FORMAT_VERSION = 1;
+    const std::size_t FLUSH_SIZE = 64 * 1024;
+
+    // Record layout: u8 type, varint timestamp delta, zigzag varints a, b, c.
+    void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void writeSigned(std::vector<std::uint8_t>& out, std::int32_t value) {
+        std::uint32_t zigzag = (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+        writeVarint(out, zigzag);
+    }
+
+    bool readVarint(std::istream& in, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = in.get();
+            if (byte == EOF) return false;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool readSigned(std::istream& in, std::int32_t& value) {
+        std::uint64_t zigzag;
+        if (!readVarint(in, zigzag)) return false;
+        std::uint32_t bits = static_cast<std::uint32_t>(zigzag);
+        value = static_cast<std::int32_t>((bits >> 1) ^ (~(bits & 1) + 1));
+        return true;
+    }
+}
+
+Telemetry::Telemetry() : running(false), dropped(0), file(nullptr) {}
+
+Telemetry::~Telemetry() {
+    stop();
+}
+
+bool Telemetry::start(const std::string& path) {
+    if (isRunning()) return true;
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Could not open telemetry log: " << path << std::endl;
+        return false;
+    }
+    std::fwrite(MAGIC, 1, sizeof(MAGIC), file);
+    std::fputc(FORMAT_VERSION, file);
+
+    clock.restart();
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&Telemetry::writerLoop, this);
+    return true;
+}
+
+void Telemetry::stop() {
+    if (!isRunning()) return;
+
+    running.store(false, std::memory_order_release);
+    writer.join();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void Telemetry::record(EventType type, std::int32_t a, std::int32_t b, std::int32_t c) {
+    if (!isRunning()) return;
+
+    Event event;
+    event.timestamp = static_cast<std::uint64_t>(clock.getElapsedTime().asMicroseconds());
+    event.type = type;
+    event.a = a;
+    event.b = b;
+    event.c = c;
+    if (!queue.tryPush(event)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Telemetry::writerLoop() {
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(FLUSH_SIZE + 64);
+    std::uint64_t lastTimestamp = 0;
+
+    auto encode = [&](const Event& event) {
+        buffer.push_back(static_cast<std::uint8_t>(event.type));
+        writeVarint(buffer, event.timestamp - lastTimestamp);
+        writeSigned(buffer, event.a);
+        writeSigned(buffer, event.b);
+        writeSigned(buffer, event.c);
+        lastTimestamp = event.timestamp;
+    };
+
+    while (true) {
+        // Read the flag before draining: once the producer has stopped, this
+        // pass is guaranteed to see everything it pushed.
+        bool stopping = !running.load(std::memory_order_acquire);
+
+        Event event;
+        std::size_t drained = 0;
+        while (queue.tryPop(event)) {
+            encode(event);
+            drained++;
+            if (buffer.size() >= FLUSH_SIZE) {
+                std::fwrite(buffer.data(), 1, buffer.size(), file);
+                buffer.clear();
+            }
+        }
+
+        std::uint32_t lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0) {
+            Event report = {std::max(lastTimestamp, static_cast<std::uint64_t>(clock.getElapsedTime().asMicroseconds())),
+                            EventType::DROPPED, static_cast<std::int32_t>(lost), 0, 0};
+            encode(report);
+        }
+
+        if (!buffer.empty()) {
+            std::fwrite(buffer.data(), 1, buffer.size(), file);
+            std::fflush(file);
+            buffer.clear();
+        }
+
+        if (stopping) break;
+        if (drained == 0) {
+            sf::sleep(sf::milliseconds(5));
+        }
+    }
+}
+
+bool Telemetry::decode(std::istream& in, const std::function<void(const Event&)>& visitor) {
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+        return false;
+    }
+    if (in.get() != FORMAT_VERSION) {
+        return false;
+    }
+
+    std::uint64_t timestamp = 0;
+    while (true) {
+        int type = in.get();
+        if (type == EOF) return true;
+
+        Event event;
+        std::uint64_t delta;
+        if (!readVarint(in, delta) || !readSigned(in, event.a) ||
+            !readSigned(in, event.b) || !readSigned(in, event.c)) {
+            return false;
+        }
+        timestamp += delta;
+        event.timestamp = timestamp;
+        event.type = static_cast<EventType>(type);
+        visitor(event);
+    }
+}
+
+const char* Telemetry::typeName(EventType type) {
+    switch (type) {
+        case EventType::SESSION_START: return "session_start";
+        case EventType::MOVE: return "move";
+        case EventType::DEATH: return "death";
+        case EventType::LEVEL_COMPLETE: return "level_complete";
+        case EventType::POWERUP_PICKUP: return "powerup_pickup";
+        case EventType::FRAME: return "frame";
+        case EventType::DROPPED: return "dropped";
+    }
+    return "unknown";
+}
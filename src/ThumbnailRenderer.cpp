@@ -0,0 +1,156 @@
+// ThumbnailRenderer.cpp
+#include "ThumbnailRenderer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace {
+    // Same palette as the in-game view.
+    const sf::Color WALL_COLOR(50, 50, 50);
+    const sf::Color OPEN_COLOR(200, 200, 200);
+    const sf::Color SOLUTION_COLOR(255, 215, 0);
+    const sf::Color SHEET_BACKGROUND(15, 15, 15);
+
+    void fillBlock(sf::Uint8* pixels, int stride, int x, int y, int size, const sf::Color& color) {
+        sf::Uint8* row = pixels + (static_cast<std::size_t>(y) * size * stride + static_cast<std::size_t>(x) * size) * 4;
+        for (int i = 0; i < size; ++i) {
+            row[i * 4 + 0] = color.r;
+            row[i * 4 + 1] = color.g;
+            row[i * 4 + 2] = color.b;
+            row[i * 4 + 3] = color.a;
+        }
+        // The remaining pixel rows of the block repeat the first one.
+        for (int i = 1; i < size; ++i) {
+            std::memcpy(row + static_cast<std::size_t>(i) * stride * 4, row, static_cast<std::size_t>(size) * 4);
+        }
+    }
+}
+
+namespace ThumbnailRenderer {
+
+int render(const GameSession& session, const Options& options, Workspace& workspace) {
+    const auto& maze = session.getMaze();
+    const int height = static_cast<int>(maze.size());
+    const int width = height > 0 ? static_cast<int>(maze[0].size()) : 0;
+    const int size = std::max(1, options.cellSize);
+    const int stride = width * size;
+    workspace.pixels.resize(static_cast<std::size_t>(stride) * height * size * 4);
+    sf::Uint8* pixels = workspace.pixels.data();
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            fillBlock(pixels, stride, x, y, size, maze[y][x] == '#' ? WALL_COLOR : OPEN_COLOR);
+        }
+    }
+
+    if (options.showSolution) {
+        workspace.graph.build(maze);
+        workspace.graph.findPath(session.getPlayerPos(), session.getEndPos(), workspace.solution);
+        for (const Point& cell : workspace.solution) {
+            fillBlock(pixels, stride, cell.x, cell.y, size, SOLUTION_COLOR);
+        }
+    }
+    for (const auto& enemy : session.getEnemies()) {
+        fillBlock(pixels, stride, enemy.getPosition().x, enemy.getPosition().y, size, sf::Color::Red);
+    }
+    fillBlock(pixels, stride, session.getPlayerPos().x, session.getPlayerPos().y, size, sf::Color::Cyan);
+    fillBlock(pixels, stride, session.getEndPos().x, session.getEndPos().y, size, sf::Color::Green);
+    return stride;
+}
+
+std::size_t renderBatch(GameSession::Difficulty difficulty, unsigned firstSeed, std::size_t count,
+                        const std::string& directory, const Options& options) {
+    unsigned threadCount = options.threadCount;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Every maze of one difficulty has the same size, so the sheet layout is
+    // known before any thumbnail is drawn.
+    GameSession sample(difficulty, firstSeed);
+    sample.generateMaze();
+    const int size = std::max(1, options.cellSize);
+    const int cellsX = static_cast<int>(sample.getMaze()[0].size());
+    const int cellsY = static_cast<int>(sample.getMaze().size());
+    const int thumbWidth = cellsX * size;
+    const int thumbHeight = cellsY * size;
+
+    // The sheet uses one pixel per cell so thousands of mazes fit in memory.
+    const int gutter = 1;
+    const int columns = options.sheetColumns;
+    const int rows = columns > 0 ? static_cast<int>((count + columns - 1) / columns) : 0;
+    const int sheetWidth = columns * (cellsX + gutter) + gutter;
+    const int sheetHeight = rows * (cellsY + gutter) + gutter;
+    std::vector<sf::Uint8> sheet;
+    if (columns > 0 && count > 0) {
+        sheet.resize(static_cast<std::size_t>(sheetWidth) * sheetHeight * 4);
+        for (std::size_t i = 0; i < sheet.size(); i += 4) {
+            sheet[i + 0] = SHEET_BACKGROUND.r;
+            sheet[i + 1] = SHEET_BACKGROUND.g;
+            sheet[i + 2] = SHEET_BACKGROUND.b;
+            sheet[i + 3] = SHEET_BACKGROUND.a;
+        }
+    }
+
+    const std::size_t blockSize = 16;
+    std::atomic<std::size_t> nextBlock(0);
+    std::atomic<std::size_t> written(0);
+    auto worker = [&]() {
+        Workspace workspace;
+        GameSession session(difficulty);
+        std::string path;
+        while (true) {
+            std::size_t begin = nextBlock.fetch_add(blockSize);
+            if (begin >= count) break;
+            std::size_t end = std::min(count, begin + blockSize);
+            for (std::size_t i = begin; i < end; ++i) {
+                unsigned seed = firstSeed + static_cast<unsigned>(i);
+                session.setSeed(seed);
+                session.generateMaze();
+                render(session, options, workspace);
+
+                // Encoding runs here, on the worker, not on the caller.
+                workspace.image.create(thumbWidth, thumbHeight, workspace.pixels.data());
+                path = directory + "/maze_" + std::to_string(seed) + ".png";
+                if (workspace.image.saveToFile(path)) {
+                    written.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                // Each thumbnail owns its own sheet slot, so no locking.
+                if (!sheet.empty()) {
+                    int left = gutter + static_cast<int>(i % columns) * (cellsX + gutter);
+                    int top = gutter + static_cast<int>(i / columns) * (cellsY + gutter);
+                    for (int y = 0; y < cellsY; ++y) {
+                        sf::Uint8* target = &sheet[(static_cast<std::size_t>(top + y) * sheetWidth + left) * 4];
+                        const sf::Uint8* source = &workspace.pixels[static_cast<std::size_t>(y) * size * thumbWidth * 4];
+                        for (int x = 0; x < cellsX; ++x) {
+                            std::memcpy(target + x * 4, source + static_cast<std::size_t>(x) * size * 4, 4);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (!sheet.empty()) {
+        sf::Image image;
+        image.create(sheetWidth, sheetHeight, sheet.data());
+        if (!image.saveToFile(directory + "/contact_sheet.png")) {
+            std::cerr << "Failed to write contact sheet to " << directory << std::endl;
+        }
+    }
+    return written.load();
+}
+
+}
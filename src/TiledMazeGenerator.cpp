@@ -0,0 +1,142 @@
+// TiledMazeGenerator.cpp
+#include "TiledMazeGenerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    const int DOWN = 1;     // SquareTopology direction indices
+    const int RIGHT = 3;
+
+    class DisjointSets {
+    public:
+        explicit DisjointSets(std::size_t count) : parent(count), rank(count, 0) {
+            for (std::size_t i = 0; i < count; ++i) parent[i] = static_cast<int>(i);
+        }
+
+        int find(int set) {
+            while (parent[set] != set) {
+                parent[set] = parent[parent[set]];  // Path halving
+                set = parent[set];
+            }
+            return set;
+        }
+
+        // Returns false when both were already joined.
+        bool unite(int a, int b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (rank[a] < rank[b]) std::swap(a, b);
+            parent[b] = a;
+            if (rank[a] == rank[b]) rank[a]++;
+            return true;
+        }
+
+    private:
+        std::vector<int> parent;
+        std::vector<unsigned char> rank;
+    };
+
+    // Per-tile seeds from a mixing hash, so neighbouring tiles get unrelated
+    // streams and the result does not depend on which thread ran a tile.
+    unsigned tileSeed(unsigned seed, std::size_t tile) {
+        std::uint64_t value = (static_cast<std::uint64_t>(seed) << 32) ^ tile;
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<unsigned>(value ^ (value >> 31));
+    }
+
+    struct Crossing {
+        GridCoord cell;
+        int direction;
+        int tileA, tileB;
+    };
+}
+
+namespace TiledMazeGenerator {
+
+void generate(TopologyMaze<SquareTopology>& maze, unsigned seed, const Options& options) {
+    const int width = maze.getWidth();
+    const int height = maze.getHeight();
+    const int tileSize = std::max(2, options.tileSize);
+    const int tilesX = (width + tileSize - 1) / tileSize;
+    const int tilesY = (height + tileSize - 1) / tileSize;
+    const std::size_t tileCount = static_cast<std::size_t>(tilesX) * tilesY;
+
+    auto tileLow = [&](std::size_t tile) {
+        return GridCoord(static_cast<int>(tile % tilesX) * tileSize, static_cast<int>(tile / tilesX) * tileSize, 0);
+    };
+    auto tileHigh = [&](std::size_t tile) {
+        GridCoord low = tileLow(tile);
+        return GridCoord(std::min(width, low.x + tileSize), std::min(height, low.y + tileSize), 1);
+    };
+
+    unsigned threadCount = options.threadCount;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, tileCount));
+
+    // Tiles cover disjoint cells and carving never leaves a tile, so workers
+    // write to the shared passage array without synchronisation.
+    std::atomic<std::size_t> nextTile(0);
+    auto worker = [&]() {
+        LinearArena scratch;
+        while (true) {
+            std::size_t tile = nextTile.fetch_add(1);
+            if (tile >= tileCount) break;
+            std::mt19937 rng(tileSeed(seed, tile));
+            GridCoord low = tileLow(tile);
+            GridCoord high = tileHigh(tile);
+            GridCoord start(low.x + static_cast<int>(rng() % static_cast<unsigned>(high.x - low.x)),
+                            low.y + static_cast<int>(rng() % static_cast<unsigned>(high.y - low.y)), 0);
+            maze.generateRegion(rng, scratch, low, high, start);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // One candidate crossing per pair of neighbouring tiles, accepted in
+    // random order while it joins two separate components: a random spanning
+    // tree over the tiles, which keeps the whole maze free of loops.
+    std::mt19937 rng(seed);
+    std::vector<Crossing> crossings;
+    crossings.reserve(tileCount * 2);
+    for (std::size_t tile = 0; tile < tileCount; ++tile) {
+        GridCoord low = tileLow(tile);
+        GridCoord high = tileHigh(tile);
+        int tileIndex = static_cast<int>(tile);
+        if (low.x + tileSize < width) {
+            int y = low.y + static_cast<int>(rng() % static_cast<unsigned>(high.y - low.y));
+            crossings.push_back({GridCoord(high.x - 1, y, 0), RIGHT, tileIndex, tileIndex + 1});
+        }
+        if (low.y + tileSize < height) {
+            int x = low.x + static_cast<int>(rng() % static_cast<unsigned>(high.x - low.x));
+            crossings.push_back({GridCoord(x, high.y - 1, 0), DOWN, tileIndex, tileIndex + tilesX});
+        }
+    }
+    std::shuffle(crossings.begin(), crossings.end(), rng);
+
+    DisjointSets tiles(tileCount);
+    for (const Crossing& crossing : crossings) {
+        if (tiles.unite(crossing.tileA, crossing.tileB)) {
+            maze.carve(crossing.cell, crossing.direction);
+        }
+    }
+
+    if (options.extraOpenings > 0) {
+        maze.addOpenings(options.extraOpenings, rng);
+    }
+}
+
+}
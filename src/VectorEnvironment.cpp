@@ -0,0 +1,244 @@
+// VectorEnvironment.cpp
+#include "VectorEnvironment.hpp"
+#include "GridTopology.hpp"
+#include <algorithm>
+
+namespace {
+    const std::size_t CHUNK_SIZE = 256;
+
+    // Episode seeds from a mixing hash of (base seed, session, episode), so a
+    // session replays the same mazes whichever worker resets it.
+    unsigned episodeSeed(unsigned seed, std::size_t session, std::uint32_t episode) {
+        std::uint64_t value = (static_cast<std::uint64_t>(seed) << 32) ^ (static_cast<std::uint64_t>(session) << 20) ^ episode;
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<unsigned>(value ^ (value >> 31));
+    }
+}
+
+VectorEnvironment::VectorEnvironment(std::size_t count, const Config& config)
+    : count(count), config(config), episodesCompleted(0), jobId(0), pending(0), stopping(false)
+    , job(Job::RESET), jobActions(nullptr), nextChunk(0) {
+    unsigned threadCount = config.threadCount;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // No point waking more workers than there are chunks.
+    std::size_t chunks = std::max<std::size_t>(1, (count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, chunks));
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.push_back(std::unique_ptr<Worker>(new Worker(config.difficulty)));
+    }
+
+    // Every session shares the difficulty, so the first generated maze fixes
+    // the grid size and enemy count for all of them.
+    GameSession& sample = workers[0]->generator;
+    sample.setSeed(config.seed);
+    sample.generateMaze();
+    height = static_cast<int>(sample.getMaze().size());
+    width = static_cast<int>(sample.getMaze()[0].size());
+    enemiesPerSession = static_cast<int>(sample.getEnemies().size());
+    enemySpeedMultiplier = sample.difficultyMultiplier();
+
+    walls.resize(count * width * height);
+    playerX.resize(count);
+    playerY.resize(count);
+    exitX.resize(count);
+    exitY.resize(count);
+    steps.resize(count);
+    episodes.resize(count);
+    enemies.assign(count * enemiesPerSession, sample.getEnemies()[0]);
+    observations.resize(count * OBSERVATION_SIZE);
+    rewards.resize(count);
+    dones.resize(count);
+
+    for (unsigned i = 1; i < threadCount; ++i) {
+        Worker& worker = *workers[i];
+        worker.thread = std::thread([this, &worker]() { workerLoop(worker); });
+    }
+    run(Job::RESET, nullptr);
+}
+
+VectorEnvironment::~VectorEnvironment() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+VectorEnvironment::Batch VectorEnvironment::reset() {
+    return run(Job::RESET, nullptr);
+}
+
+VectorEnvironment::Batch VectorEnvironment::step(const GameSession::Action* actions) {
+    return run(Job::STEP, actions);
+}
+
+VectorEnvironment::Batch VectorEnvironment::run(Job newJob, const GameSession::Action* actions) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = newJob;
+        jobActions = actions;
+        nextChunk.store(0, std::memory_order_relaxed);
+        pending = static_cast<unsigned>(workers.size() - 1);
+        ++jobId;
+    }
+    if (workers.size() > 1) {
+        wake.notify_all();
+    }
+    runChunks(*workers[0]);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return pending == 0; });
+    return batch();
+}
+
+void VectorEnvironment::workerLoop(Worker& worker) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || jobId != seen; });
+            if (stopping) return;
+            seen = jobId;
+        }
+        runChunks(worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+}
+
+void VectorEnvironment::runChunks(Worker& worker) {
+    while (true) {
+        std::size_t begin = nextChunk.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+        if (begin >= count) break;
+        std::size_t end = std::min(count, begin + CHUNK_SIZE);
+        if (job == Job::RESET) {
+            for (std::size_t i = begin; i < end; ++i) {
+                episodes[i] = 0;
+                resetSession(i, worker);
+                rewards[i] = 0.0f;
+                dones[i] = 0;
+            }
+        } else {
+            for (std::size_t i = begin; i < end; ++i) {
+                stepSession(i, jobActions[i], worker);
+            }
+        }
+    }
+}
+
+void VectorEnvironment::resetSession(std::size_t index, Worker& worker) {
+    GameSession& generator = worker.generator;
+    generator.setSeed(episodeSeed(config.seed, index, episodes[index]++));
+    generator.generateMaze();
+
+    const auto& maze = generator.getMaze();
+    std::uint8_t* grid = &walls[index * width * height];
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            grid[y * width + x] = maze[y][x] == '#';
+        }
+    }
+    playerX[index] = static_cast<std::int16_t>(generator.getPlayerPos().x);
+    playerY[index] = static_cast<std::int16_t>(generator.getPlayerPos().y);
+    exitX[index] = static_cast<std::int16_t>(generator.getEndPos().x);
+    exitY[index] = static_cast<std::int16_t>(generator.getEndPos().y);
+    steps[index] = 0;
+
+    // Copy-assigning reuses each enemy's patrol path storage.
+    const auto& source = generator.getEnemies();
+    std::copy(source.begin(), source.end(), enemies.begin() + index * enemiesPerSession);
+    observe(index);
+}
+
+void VectorEnvironment::stepSession(std::size_t index, GameSession::Action action, Worker& worker) {
+    float reward = config.stepReward;
+    bool done = false;
+
+    // Same rules as GameSession::applyAction followed by update().
+    if (action >= GameSession::Action::UP && action <= GameSession::Action::RIGHT) {
+        const GridOffset& offset = SquareTopology::OFFSETS[0][static_cast<int>(action) - static_cast<int>(GameSession::Action::UP)];
+        int x = playerX[index] + offset.dx;
+        int y = playerY[index] + offset.dy;
+        if (x >= 0 && y >= 0 && x < width && y < height && !walls[index * width * height + y * width + x]) {
+            playerX[index] = static_cast<std::int16_t>(x);
+            playerY[index] = static_cast<std::int16_t>(y);
+        }
+    }
+    Point player(playerX[index], playerY[index]);
+    if (player.x == exitX[index] && player.y == exitY[index]) {
+        reward += config.exitReward;
+        done = true;
+    } else {
+        Enemy* first = &enemies[index * enemiesPerSession];
+        for (int i = 0; i < enemiesPerSession; ++i) {
+            first[i].update(config.stepTime * enemySpeedMultiplier);
+            if (first[i].checkCollision(player)) {
+                reward += config.caughtReward;
+                done = true;
+                break;
+            }
+        }
+    }
+    if (++steps[index] >= config.maxSteps) {
+        done = true;
+    }
+
+    rewards[index] = reward;
+    dones[index] = done;
+    if (done) {
+        // The returned observation is the first one of the next episode.
+        episodesCompleted.fetch_add(1, std::memory_order_relaxed);
+        resetSession(index, worker);
+    } else {
+        observe(index);
+    }
+}
+
+void VectorEnvironment::observe(std::size_t index) {
+    const std::uint8_t* grid = &walls[index * width * height];
+    std::uint8_t* out = &observations[index * OBSERVATION_SIZE];
+    const int px = playerX[index];
+    const int py = playerY[index];
+
+    for (int dy = -VIEW_RADIUS; dy <= VIEW_RADIUS; ++dy) {
+        int y = py + dy;
+        for (int dx = -VIEW_RADIUS; dx <= VIEW_RADIUS; ++dx) {
+            int x = px + dx;
+            bool inside = x >= 0 && y >= 0 && x < width && y < height;
+            *out++ = !inside || grid[y * width + x] ? WALL : OPEN;
+        }
+    }
+    out = &observations[index * OBSERVATION_SIZE];
+
+    auto mark = [&](int x, int y, Cell cell) {
+        int dx = x - px;
+        int dy = y - py;
+        if (dx >= -VIEW_RADIUS && dx <= VIEW_RADIUS && dy >= -VIEW_RADIUS && dy <= VIEW_RADIUS) {
+            out[(dy + VIEW_RADIUS) * VIEW_SIZE + dx + VIEW_RADIUS] = cell;
+        }
+    };
+    mark(exitX[index], exitY[index], EXIT);
+    const Enemy* first = &enemies[index * enemiesPerSession];
+    for (int i = 0; i < enemiesPerSession; ++i) {
+        mark(first[i].getPosition().x, first[i].getPosition().y, ENEMY);
+    }
+
+    out += VIEW_SIZE * VIEW_SIZE;
+    out[0] = exitX[index] > px;
+    out[1] = exitX[index] < px;
+    out[2] = exitY[index] > py;
+    out[3] = exitY[index] < py;
+}
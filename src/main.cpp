@@ -1,10 +1,189 @@
 // main.cpp
 #include "MazeGame.hpp"
+#include "GameServer.hpp"
+#include "MazeAnalytics.hpp"
+#include "TiledMazeGenerator.hpp"
+#include "ThumbnailRenderer.hpp"
+#include "VectorEnvironment.hpp"
+#include <SFML/System.hpp>
 #include <iostream>
+#include <random>
+#include <string>
+#include <thread>
 
-int main() {
+namespace {
+    // --server unix:/path/to.sock  or  --server <port>
+    int runServer(const std::string& endpoint) {
+        GameServer server;
+        bool listening;
+        if (endpoint.compare(0, 5, "unix:") == 0) {
+            listening = server.listenUnix(endpoint.substr(5));
+        } else {
+            int port = std::stoi(endpoint);
+            if (port < 1 || port > 65535) {
+                std::cerr << "Usage: --server unix:<path> | --server <port> (port must be 1-65535)" << std::endl;
+                return 1;
+            }
+            listening = server.listenTcp(static_cast<unsigned short>(port));
+        }
+        if (!listening) {
+            return 1;
+        }
+        server.run();
+        return 0;
+    }
+
+    GameSession::Difficulty parseDifficulty(const std::string& name) {
+        if (name == "easy") return GameSession::Difficulty::EASY;
+        if (name == "hard") return GameSession::Difficulty::HARD;
+        return GameSession::Difficulty::MEDIUM;
+    }
+
+    // --analyze <count> [easy|medium|hard]
+    int runAnalytics(std::size_t count, GameSession::Difficulty difficulty) {
+        if (count == 0) {
+            std::cerr << "Usage: --analyze <count> [easy|medium|hard] (count must be at least 1)" << std::endl;
+            return 1;
+        }
+        const int tierCount = 3;
+        sf::Clock clock;
+        auto results = MazeAnalytics::analyzeBatch(difficulty, 1, count);
+        float seconds = clock.getElapsedTime().asSeconds();
+        auto boundaries = MazeAnalytics::calibrateTiers(results, tierCount);
+
+        std::vector<int> tierSizes(tierCount, 0);
+        double solution = 0, deadEnds = 0, branching = 0;
+        for (const auto& metrics : results) {
+            tierSizes[metrics.tier]++;
+            solution += metrics.solutionLength;
+            deadEnds += metrics.deadEnds;
+            branching += metrics.branchingFactor;
+        }
+
+        std::cout << "Analyzed " << count << " mazes in " << seconds << "s ("
+                  << static_cast<long long>(count / std::max(seconds, 1e-6f) * 3600) << " per hour)\n"
+                  << "Mean solution length: " << solution / count << "\n"
+                  << "Mean dead ends: " << deadEnds / count << "\n"
+                  << "Mean branching factor: " << branching / count << "\n";
+        for (int i = 0; i < tierCount; ++i) {
+            std::cout << "Tier " << i << ": " << tierSizes[i] << " mazes";
+            if (i < static_cast<int>(boundaries.size())) std::cout << " (score < " << boundaries[i] << ")";
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    // --generate <size> [extra openings]
+    int runGenerator(int size, int extraOpenings) {
+        if (size < 1) {
+            std::cerr << "Usage: --generate <size> [extra openings] (size must be at least 1)" << std::endl;
+            return 1;
+        }
+        TopologyMaze<SquareTopology> maze(size, size);
+        TiledMazeGenerator::Options options;
+        options.extraOpenings = extraOpenings;
+
+        sf::Clock clock;
+        TiledMazeGenerator::generate(maze, 1, options);
+        float seconds = clock.getElapsedTime().asSeconds();
+
+        LinearArena scratch;
+        int solution = maze.solve(GridCoord(0, 0), GridCoord(size - 1, size - 1), scratch);
+        std::cout << "Generated " << size << "x" << size << " maze in " << seconds << "s ("
+                  << options.tileSize << "-cell tiles, " << std::thread::hardware_concurrency() << " threads)\n"
+                  << "Corner-to-corner solution length: " << solution << "\n";
+        return 0;
+    }
+
+    // --bench-env <sessions> [easy|medium|hard]
+    int runEnvironmentBenchmark(std::size_t sessions, GameSession::Difficulty difficulty) {
+        if (sessions == 0) {
+            std::cerr << "Usage: --bench-env <sessions> [easy|medium|hard] (sessions must be at least 1)" << std::endl;
+            return 1;
+        }
+        const int stepCount = 1000;
+        VectorEnvironment::Config config;
+        config.difficulty = difficulty;
+        VectorEnvironment environment(sessions, config);
+
+        // Random actions, drawn up front so the timing covers only step().
+        std::mt19937 rng(1);
+        std::vector<GameSession::Action> actions(sessions * 16);
+        for (auto& action : actions) {
+            action = static_cast<GameSession::Action>(static_cast<int>(GameSession::Action::UP) + rng() % 4);
+        }
+
+        sf::Clock clock;
+        double reward = 0;
+        for (int i = 0; i < stepCount; ++i) {
+            auto batch = environment.step(&actions[(i % 16) * sessions]);
+            reward += batch.rewards[0];
+        }
+        float seconds = clock.getElapsedTime().asSeconds();
+
+        std::cout << "Stepped " << sessions << " sessions x " << stepCount << " in " << seconds << "s ("
+                  << static_cast<long long>(sessions * stepCount / std::max(seconds, 1e-6f)) << " steps per second)\n"
+                  << "Episodes completed: " << environment.getEpisodesCompleted() << "\n"
+                  << "Session 0 return: " << reward << "\n";
+        return 0;
+    }
+
+    // --thumbnails <count> <directory> [easy|medium|hard] [sheet columns]
+    int runThumbnails(std::size_t count, const std::string& directory, GameSession::Difficulty difficulty,
+                      int sheetColumns) {
+        ThumbnailRenderer::Options options;
+        options.sheetColumns = sheetColumns;
+
+        sf::Clock clock;
+        std::size_t written = ThumbnailRenderer::renderBatch(difficulty, 1, count, directory, options);
+        float seconds = clock.getElapsedTime().asSeconds();
+
+        std::cout << "Wrote " << written << " of " << count << " thumbnails to " << directory << " in "
+                  << seconds << "s (" << static_cast<long long>(written / std::max(seconds, 1e-6f))
+                  << " per second)\n";
+        return written == count ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
     try {
-        MazeGame game;
+        if (argc == 3 && std::string(argv[1]) == "--server") {
+            return runServer(argv[2]);
+        }
+        if (argc >= 3 && std::string(argv[1]) == "--analyze") {
+            return runAnalytics(std::stoul(argv[2]), parseDifficulty(argc >= 4 ? argv[3] : ""));
+        }
+        if (argc >= 3 && std::string(argv[1]) == "--generate") {
+            return runGenerator(std::stoi(argv[2]), argc >= 4 ? std::stoi(argv[3]) : 0);
+        }
+        if (argc >= 3 && std::string(argv[1]) == "--bench-env") {
+            return runEnvironmentBenchmark(std::stoul(argv[2]), parseDifficulty(argc >= 4 ? argv[3] : ""));
+        }
+        if (argc >= 4 && std::string(argv[1]) == "--thumbnails") {
+            return runThumbnails(std::stoul(argv[2]), argv[3], parseDifficulty(argc >= 5 ? argv[4] : ""),
+                                 argc >= 6 ? std::stoi(argv[5]) : 0);
+        }
+
+        // Game options: --pacing <policy>, --telemetry <log file>
+        FramePacer::Policy pacing = FramePacer::Policy::CAPPED;
+        std::string telemetryPath;
+        for (int i = 1; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            if (option == "--pacing") {
+                if (!FramePacer::parsePolicy(argv[i + 1], pacing)) {
+                    std::cerr << "Unknown pacing policy: " << argv[i + 1]
+                              << " (uncapped, capped, low-latency, power-saver)" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--telemetry") {
+                telemetryPath = argv[i + 1];
+            } else {
+                std::cerr << "Unknown option: " << option << std::endl;
+                return 1;
+            }
+        }
+
+        MazeGame game(pacing, telemetryPath);
         game.run();
     }
     catch (const std::exception& e) {
@@ -12,4 +191,4 @@ int main() {
         return 1;
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,16 @@
+// AllocationCounter.hpp
+#pragma once
+#include <cstddef>
+
+// Counts calls to the replaced global operator new (see AllocationCounter.cpp)
+// so test tools can check hot paths for heap traffic:
+//
+//     std::size_t before = AllocationCounter::total();
+//     session.generateMaze();
+//     assert(AllocationCounter::total() == before);
+//
+// Link it into test tools only; in the game every allocation, SFML's
+// included, would pay for the counter.
+namespace AllocationCounter {
+    std::size_t total();
+}
@@ -0,0 +1,136 @@
+// allocation_check.cpp
+// Checks with AllocationCounter that steady-state work reuses its buffers:
+// after a warm-up, 200 maze regenerations must allocate no more than 4 do,
+// and the per-tick and per-frame game work must not allocate at all.
+#include "AllocationCounter.hpp"
+#include "FieldOfView.hpp"
+#include "GameSession.hpp"
+#include "InputController.hpp"
+#include "JunctionGraph.hpp"
+#include "RewindBuffer.hpp"
+#include "SpscQueue.hpp"
+#include "Telemetry.hpp"
+#include "Constants.hpp"
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+namespace {
+    const unsigned WARM_UP = 3;
+    const unsigned FEW = 4;
+    const unsigned MANY = 200;
+    const int WARM_UP_TICKS = 3000;     // Past the rewind capacity, so its ring is full
+    const int MEASURED_TICKS = 3000;
+
+    // Heap allocations made by `count` regenerations with fresh seeds.
+    std::size_t regenerations(GameSession& session, unsigned& seed, unsigned count) {
+        std::size_t before = AllocationCounter::total();
+        for (unsigned i = 0; i < count; ++i) {
+            session.setSeed(seed++);
+            session.generateMaze();
+        }
+        return AllocationCounter::total() - before;
+    }
+
+    // The headless share of MazeGame's work: the simulation tick (input,
+    // session step, rewind capture, telemetry) and the render side's fog of
+    // war and hint path. Drawing and snapshot publishing need a window.
+    class TickLoop {
+    public:
+        TickLoop()
+            : session(GameSession::Difficulty::HARD, 5), rewindBuffer(GameConstants::REWIND_TICKS)
+            , tick(0), now(0), graphVersion(0) {
+            session.startNewGame();
+            // Running, so record() goes through the queue rather than returning early.
+            telemetry.start("/dev/null");
+        }
+
+        // Heap allocations made by `count` ticks of a scripted player.
+        std::size_t run(int count) {
+            const sf::Int64 tickMicros = 1000000 / GameConstants::SIMULATION_TICK_RATE;
+            std::size_t before = AllocationCounter::total();
+            for (int i = 0; i < count; ++i) {
+                now += tickMicros;
+                auto action = static_cast<GameSession::Action>(1 + (tick / 40) % 4);
+                if (tick % 40 == 0) input.keyPressed(action, now);
+                if (tick % 40 == 30) input.keyReleased(action, now);
+
+                InputController::Command commands[InputController::BUFFER_SIZE];
+                std::size_t moves = input.collect(now, commands, InputController::BUFFER_SIZE);
+                for (std::size_t m = 0; m < moves; ++m) {
+                    if (session.applyAction(commands[m].action) == GameSession::StepResult::NONE) continue;
+                    input.recordApplied(commands[m], now);
+                    telemetry.record(Telemetry::EventType::MOVE, session.getPlayerPos().x, session.getPlayerPos().y);
+                }
+                if (session.update(1.0f / GameConstants::SIMULATION_TICK_RATE) == GameSession::StepResult::CAUGHT) {
+                    session.startNewGame();
+                }
+                rewindBuffer.capture(session, ++tick);
+
+                const auto& maze = session.getMaze();
+                if (graphVersion != session.getGridVersion()) {
+                    fieldOfView.reset(static_cast<int>(maze[0].size()), static_cast<int>(maze.size()));
+                    graph.build(maze, {session.getEndPos()});
+                    graphVersion = session.getGridVersion();
+                }
+                fieldOfView.update(maze, session.getPlayerPos(), GameConstants::FOG_VIEW_RADIUS);
+                graph.findPath(session.getPlayerPos(), session.getEndPos(), hintPath);
+            }
+            return AllocationCounter::total() - before;
+        }
+
+    private:
+        GameSession session;
+        InputController input;
+        RewindBuffer rewindBuffer;
+        Telemetry telemetry;
+        FieldOfView fieldOfView;
+        JunctionGraph graph;
+        std::vector<Point> hintPath;
+        std::uint32_t tick;
+        sf::Int64 now;
+        unsigned graphVersion;
+    };
+}
+
+int main() {
+    bool ok = true;
+
+    for (int level = 0; level <= static_cast<int>(GameSession::Difficulty::HARD); ++level) {
+        GameSession session(static_cast<GameSession::Difficulty>(level));
+        unsigned seed = 1;
+        regenerations(session, seed, WARM_UP);
+
+        std::size_t few = regenerations(session, seed, FEW);
+        std::size_t many = regenerations(session, seed, MANY);
+        std::cout << "Difficulty " << level << ": " << few << " allocations over " << FEW << " regenerations, "
+                  << many << " over " << MANY << "\n";
+        if (many > few) {
+            std::cerr << "Allocations grow with the number of regenerations" << std::endl;
+            ok = false;
+        }
+    }
+
+    TickLoop loop;
+    loop.run(WARM_UP_TICKS);
+    std::size_t ticks = loop.run(MEASURED_TICKS);
+    std::cout << "Steady state: " << ticks << " allocations over " << MEASURED_TICKS << " ticks\n";
+    if (ticks != 0) {
+        std::cerr << "Steady-state ticks allocate" << std::endl;
+        ok = false;
+    }
+
+    // Over-aligned types go through the aligned operator new overloads.
+    std::size_t before = AllocationCounter::total();
+    std::unique_ptr<SpscQueue<int, 64>> queue(new SpscQueue<int, 64>());
+    if (AllocationCounter::total() - before != 1) {
+        std::cerr << "Aligned allocation was not counted" << std::endl;
+        ok = false;
+    }
+    if (reinterpret_cast<std::uintptr_t>(queue.get()) % alignof(SpscQueue<int, 64>) != 0) {
+        std::cerr << "Aligned allocation is misaligned" << std::endl;
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
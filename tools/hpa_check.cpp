@@ -0,0 +1,155 @@
+// hpa_check.cpp
+// Checks HierarchicalPathfinder against a plain BFS on a large tiled maze.
+// On the perfect maze every HPA* path must be exactly as long as BFS. After
+// setCell() cuts a passage or opens a wall, both on a cluster border and
+// inside a cluster, the updated pathfinder must answer every query the same
+// as one rebuilt from scratch, and never beat BFS.
+#include "HierarchicalPathfinder.hpp"
+#include "TiledMazeGenerator.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using Grid = std::vector<std::vector<char>>;
+
+    const int MAZE_CELLS = 256;     // Passage cells per side; the grid is 513x513
+    const int TILE_SIZE = 64;       // Several tiles, so stitched borders are covered
+    const int QUERIES = 40;
+
+    int bfsDistance(const Grid& grid, const Point& from, const Point& to, std::vector<int>& distance) {
+        const int height = static_cast<int>(grid.size());
+        const int width = static_cast<int>(grid[0].size());
+        if (grid[from.y][from.x] == '#' || grid[to.y][to.x] == '#') return -1;
+
+        static const int DX[4] = {0, 0, -1, 1};
+        static const int DY[4] = {-1, 1, 0, 0};
+        distance.assign(static_cast<std::size_t>(width) * height, -1);
+        std::vector<Point> queue;
+        queue.push_back(from);
+        distance[from.y * width + from.x] = 0;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            Point cell = queue[head];
+            if (cell == to) return distance[cell.y * width + cell.x];
+            for (int k = 0; k < 4; ++k) {
+                int x = cell.x + DX[k];
+                int y = cell.y + DY[k];
+                if (x < 0 || y < 0 || x >= width || y >= height || grid[y][x] == '#' || distance[y * width + x] >= 0) {
+                    continue;
+                }
+                distance[y * width + x] = distance[cell.y * width + cell.x] + 1;
+                queue.push_back(Point(x, y));
+            }
+        }
+        return -1;
+    }
+
+    bool validPath(const Grid& grid, const std::vector<Point>& path, const Point& from, const Point& to, int length) {
+        if (length < 0) return path.empty();
+        if (static_cast<int>(path.size()) != length + 1 || path.front() != from || path.back() != to) return false;
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            if (grid[path[i].y][path[i].x] == '#') return false;
+            if (i > 0 && std::abs(path[i].x - path[i - 1].x) + std::abs(path[i].y - path[i - 1].y) != 1) return false;
+        }
+        return true;
+    }
+
+    struct Query {
+        Point from, to;
+    };
+
+    // Runs every query. exact demands BFS lengths (perfect maze); otherwise
+    // HPA* may be longer than BFS but must agree with the reference build.
+    int runQueries(const char* stage, const Grid& grid, const std::vector<Query>& queries, bool exact,
+                   HierarchicalPathfinder& pathfinder, HierarchicalPathfinder* reference) {
+        std::vector<int> scratch;
+        std::vector<Point> path, waypoints, referencePath;
+        int failures = 0;
+        for (const Query& query : queries) {
+            int expected = bfsDistance(grid, query.from, query.to, scratch);
+            int found = pathfinder.findPath(query.from, query.to, path);
+            int waypointLength = pathfinder.findWaypoints(query.from, query.to, waypoints);
+            bool ok = validPath(grid, path, query.from, query.to, found) && waypointLength == found &&
+                      (expected < 0 ? found < 0 : found >= expected) && (!exact || found == expected);
+            if (reference && reference->findPath(query.from, query.to, referencePath) != found) {
+                ok = false;
+            }
+            if (!ok) {
+                std::cerr << stage << ": (" << query.from.x << "," << query.from.y << ") -> (" << query.to.x << ","
+                          << query.to.y << ") BFS " << expected << ", HPA* " << found << std::endl;
+                failures++;
+            }
+        }
+        return failures;
+    }
+
+    // Rebuilds a reference from the edited grid, then checks the incremental one.
+    int afterEdit(const char* stage, Grid& grid, const Point& cell, bool open, const std::vector<Query>& queries,
+                  HierarchicalPathfinder& pathfinder, bool exact) {
+        grid[cell.y][cell.x] = open ? ' ' : '#';
+        pathfinder.setCell(cell.x, cell.y, open);
+        HierarchicalPathfinder reference;
+        reference.build(grid);
+        return runQueries(stage, grid, queries, exact, pathfinder, &reference);
+    }
+}
+
+int main() {
+    TopologyMaze<SquareTopology> maze(MAZE_CELLS, MAZE_CELLS);
+    TiledMazeGenerator::Options options;
+    options.tileSize = TILE_SIZE;
+    TiledMazeGenerator::generate(maze, 11, options);
+    Grid grid = rasterize(maze);
+
+    HierarchicalPathfinder pathfinder;
+    pathfinder.build(grid);
+    const int clusterSize = pathfinder.getClusterSize();
+
+    std::mt19937 rng(3);
+    auto randomCell = [&]() {
+        return Point(1 + 2 * static_cast<int>(rng() % MAZE_CELLS), 1 + 2 * static_cast<int>(rng() % MAZE_CELLS));
+    };
+    std::vector<Query> queries;
+    for (int i = 0; i < QUERIES; ++i) {
+        queries.push_back({randomCell(), randomCell()});
+    }
+
+    int failures = runQueries("perfect maze", grid, queries, true, pathfinder, nullptr);
+
+    // Passage cells on the first query's route: one on a cluster border
+    // (rebuilds both clusters) and one strictly inside a cluster.
+    std::vector<Point> route;
+    pathfinder.findPath(queries[0].from, queries[0].to, route);
+    Point border(-1, -1), inner(-1, -1);
+    for (const Point& cell : route) {
+        if ((cell.x + cell.y) % 2 == 0) continue;   // Only passages between two cells
+        int local = cell.x % clusterSize;
+        bool onBorder = local == 0 || local == clusterSize - 1;
+        if (onBorder && border.x < 0) border = cell;
+        if (!onBorder && local > 1 && local < clusterSize - 2 && inner.x < 0) inner = cell;
+    }
+    if (border.x < 0 || inner.x < 0) {
+        std::cerr << "First query's route has no suitable passage cells" << std::endl;
+        return 1;
+    }
+
+    // Cutting a passage of a perfect maze disconnects the route; restoring it
+    // must give back exact answers.
+    failures += afterEdit("border passage cut", grid, border, false, queries, pathfinder, false);
+    failures += afterEdit("border passage restored", grid, border, true, queries, pathfinder, true);
+    failures += afterEdit("inner passage cut", grid, inner, false, queries, pathfinder, false);
+    failures += afterEdit("inner passage restored", grid, inner, true, queries, pathfinder, true);
+
+    // Opening walls adds loops, where HPA* may be longer than BFS.
+    for (int i = 0; i < 8; ++i) {
+        Point cell = randomCell();
+        cell.x += (i % 2 == 0 && cell.x + 1 < static_cast<int>(grid[0].size()) - 1) ? 1 : 0;
+        cell.y += (i % 2 == 1 && cell.y + 1 < static_cast<int>(grid.size()) - 1) ? 1 : 0;
+        failures += afterEdit("wall opened", grid, cell, true, queries, pathfinder, false);
+    }
+
+    std::cout << (failures == 0 ? "OK" : "FAILED") << ": " << QUERIES << " queries on a " << grid[0].size() << "x"
+              << grid.size() << " maze across 13 grid states" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// junction_graph_check.cpp
+// Fuzzes JunctionGraph against a plain BFS. Each trial builds the graph on a
+// generated maze or a random grid, then alternates random wall toggles
+// through setCell() with random queries. Every distance must equal the BFS
+// distance, every path must be a valid walk of that length, and the updated
+// graph must carry the same total corridor length as one built from scratch.
+#include "JunctionGraph.hpp"
+#include "GameSession.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using Grid = std::vector<std::vector<char>>;
+
+    const int TRIALS = 300;
+    const int TOGGLES_PER_TRIAL = 60;
+    const int QUERIES_PER_TOGGLE = 20;
+
+    int bfsDistance(const Grid& grid, const Point& from, const Point& to, std::vector<int>& distance) {
+        const int height = static_cast<int>(grid.size());
+        const int width = static_cast<int>(grid[0].size());
+        if (grid[from.y][from.x] == '#' || grid[to.y][to.x] == '#') return -1;
+
+        static const int DX[4] = {0, 0, -1, 1};
+        static const int DY[4] = {-1, 1, 0, 0};
+        distance.assign(static_cast<std::size_t>(width) * height, -1);
+        std::vector<Point> queue;
+        queue.push_back(from);
+        distance[from.y * width + from.x] = 0;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            Point cell = queue[head];
+            if (cell == to) return distance[cell.y * width + cell.x];
+            for (int k = 0; k < 4; ++k) {
+                int x = cell.x + DX[k];
+                int y = cell.y + DY[k];
+                if (x < 0 || y < 0 || x >= width || y >= height || grid[y][x] == '#' || distance[y * width + x] >= 0) {
+                    continue;
+                }
+                distance[y * width + x] = distance[cell.y * width + cell.x] + 1;
+                queue.push_back(Point(x, y));
+            }
+        }
+        return -1;
+    }
+
+    bool validPath(const Grid& grid, const std::vector<Point>& path, const Point& from, const Point& to, int length) {
+        if (length < 0) return path.empty();
+        if (static_cast<int>(path.size()) != length + 1 || path.front() != from || path.back() != to) return false;
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            if (grid[path[i].y][path[i].x] == '#') return false;
+            if (i > 0 && std::abs(path[i].x - path[i - 1].x) + std::abs(path[i].y - path[i - 1].y) != 1) return false;
+        }
+        return true;
+    }
+
+    long totalCorridorLength(const JunctionGraph& graph) {
+        long total = 0;
+        for (const auto& edge : graph.getEdges()) {
+            if (edge.live) total += edge.length;
+        }
+        return total;
+    }
+
+    // Odd trials use an unstructured grid, which has open areas and many
+    // small rings a generated maze never produces.
+    Grid makeGrid(int trial, std::mt19937& rng, std::vector<Point>& landmarks) {
+        GameSession session(static_cast<GameSession::Difficulty>(trial % 3), static_cast<unsigned>(trial));
+        session.generateMaze();
+        landmarks.clear();
+        if (trial % 4 < 2) {
+            landmarks.push_back(session.getPlayerPos());
+            landmarks.push_back(session.getEndPos());
+        }
+        if (trial % 2 == 0) {
+            return session.getMaze();
+        }
+
+        int size = 5 + static_cast<int>(rng() % 36);
+        int wallPercent = 25 + static_cast<int>(rng() % 30);
+        Grid grid(size, std::vector<char>(size, ' '));
+        for (auto& row : grid) {
+            for (char& cell : row) {
+                if (static_cast<int>(rng() % 100) < wallPercent) cell = '#';
+            }
+        }
+        for (auto& landmark : landmarks) {
+            landmark = Point(static_cast<int>(rng() % size), static_cast<int>(rng() % size));
+            grid[landmark.y][landmark.x] = ' ';
+        }
+        return grid;
+    }
+}
+
+int main() {
+    std::mt19937 rng(5);
+    std::vector<int> scratch;
+    std::vector<Point> path;
+    std::vector<Point> landmarks;
+    long queries = 0;
+    long failures = 0;
+
+    for (int trial = 0; trial < TRIALS; ++trial) {
+        Grid grid = makeGrid(trial, rng, landmarks);
+        const int height = static_cast<int>(grid.size());
+        const int width = static_cast<int>(grid[0].size());
+        JunctionGraph graph;
+        graph.build(grid, landmarks);
+
+        for (int toggle = 0; toggle <= TOGGLES_PER_TRIAL; ++toggle) {
+            if (toggle > 0) {
+                int x = static_cast<int>(rng() % width);
+                int y = static_cast<int>(rng() % height);
+                bool open = grid[y][x] == '#';
+                grid[y][x] = open ? ' ' : '#';
+                graph.setCell(x, y, open);
+
+                JunctionGraph fresh;
+                fresh.build(grid, landmarks);
+                if (totalCorridorLength(fresh) != totalCorridorLength(graph)) {
+                    std::cerr << "Trial " << trial << ", toggle " << toggle << ": updated graph differs from a rebuild"
+                              << std::endl;
+                    failures++;
+                }
+            }
+
+            for (int q = 0; q < QUERIES_PER_TOGGLE; ++q) {
+                Point from(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+                Point to(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+                if (q == 0 && !landmarks.empty()) {
+                    from = landmarks[0];
+                    to = landmarks[1];
+                }
+                int expected = bfsDistance(grid, from, to, scratch);
+                int found = graph.findPath(from, to, path);
+                int distance = graph.distance(from, to);
+                queries++;
+                if (found != expected || distance != expected || !validPath(grid, path, from, to, found)) {
+                    if (failures < 10) {
+                        std::cerr << "Trial " << trial << ", toggle " << toggle << ": (" << from.x << "," << from.y
+                                  << ") -> (" << to.x << "," << to.y << ") BFS " << expected << ", path " << found
+                                  << ", distance " << distance << std::endl;
+                    }
+                    failures++;
+                }
+            }
+        }
+    }
+
+    std::cout << queries << " queries, " << failures << " failures" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+// server_loopback.cpp
+// Drives an in-process GameServer and talks to it over a Unix socket and over
+// TCP the way a remote client would. Every snapshot is decoded against the
+// base it names and must match a full snapshot of the client's session taken
+// at the same tick. The TCP client also stops acking for longer than the
+// server's history, which must keep deltas coming against its acked base, and
+// then acks an evicted snapshot, which must fall back to a full snapshot.
+#include "GameServer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace {
+    const int TICK_RATE = 200;
+    const std::uint32_t MAX_TICKS = 3000;
+
+    struct LoopbackClient {
+        const char* name;
+        int fd;
+        std::vector<std::uint8_t> inbox;
+        std::map<std::uint32_t, NetProtocol::Snapshot> received;    // By snapshot id
+        std::map<std::uint32_t, NetProtocol::Snapshot> expected;    // By tick
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> arrivals; // (id, base id) since last drain
+        std::size_t deltas;
+
+        explicit LoopbackClient(const char* name) : name(name), fd(-1), deltas(0) {}
+        ~LoopbackClient() {
+            if (fd >= 0) close(fd);
+        }
+    };
+
+    bool setNonBlocking(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    int connectTo(int domain, const void* address, unsigned addressLength) {
+        int fd = socket(domain, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (connect(fd, static_cast<const sockaddr*>(address), addressLength) != 0 || !setNonBlocking(fd)) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    int connectUnix(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        return connectTo(AF_UNIX, &address, sizeof(address));
+    }
+
+    int connectTcp(unsigned short port) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return connectTo(AF_INET, &address, sizeof(address));
+    }
+
+    bool sendAll(int fd, const std::vector<std::uint8_t>& data) {
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            ssize_t sent = send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+            if (sent > 0) {
+                offset += sent;
+            } else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool sendAck(LoopbackClient& client, std::uint32_t id) {
+        std::vector<std::uint8_t> message;
+        NetProtocol::writeAck(id, message);
+        return sendAll(client.fd, message);
+    }
+
+    // The state a full snapshot carries, round-tripped through the wire format.
+    NetProtocol::Snapshot fullSnapshot(const GameSession& session, std::uint32_t tick) {
+        NetProtocol::Snapshot current = NetProtocol::capture(session, 0, tick, nullptr);
+        std::vector<std::uint8_t> buffer;
+        NetProtocol::writeSnapshot(current, nullptr, buffer);
+
+        NetProtocol::MessageType type;
+        const std::uint8_t* payload;
+        std::size_t payloadSize, consumed;
+        NetProtocol::Snapshot decoded;
+        NetProtocol::nextFrame(buffer, 0, type, payload, payloadSize, consumed);
+        NetProtocol::readSnapshot(payload, payloadSize, nullptr, decoded);
+        return decoded;
+    }
+
+    bool sameState(const NetProtocol::Snapshot& a, const NetProtocol::Snapshot& b) {
+        if (a.tick != b.tick || a.width != b.width || a.height != b.height || a.gridVersion != b.gridVersion ||
+            a.player != b.player || a.end != b.end || a.enemies != b.enemies) {
+            return false;
+        }
+        if (a.stats.score != b.stats.score || a.stats.moveCount != b.stats.moveCount ||
+            a.stats.timeElapsedMs != b.stats.timeElapsedMs || a.stats.highScore != b.stats.highScore ||
+            a.stats.powerUpsCollected != b.stats.powerUpsCollected) {
+            return false;
+        }
+        for (int y = 0; y < a.height; ++y) {
+            for (int x = 0; x < a.width; ++x) {
+                if (a.isWall(x, y) != b.isWall(x, y)) return false;
+            }
+        }
+        return true;
+    }
+
+    // Reads everything pending and checks each snapshot against the state
+    // recorded for its tick.
+    bool drain(LoopbackClient& client) {
+        std::uint8_t buffer[4096];
+        while (true) {
+            ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                client.inbox.insert(client.inbox.end(), buffer, buffer + received);
+                continue;
+            }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (received < 0 && errno == EINTR) continue;
+            std::cerr << client.name << ": connection lost" << std::endl;
+            return false;
+        }
+
+        std::size_t offset = 0;
+        while (true) {
+            NetProtocol::MessageType type;
+            const std::uint8_t* payload;
+            std::size_t payloadSize, consumed;
+            auto status = NetProtocol::nextFrame(client.inbox, offset, type, payload, payloadSize, consumed);
+            if (status == NetProtocol::FrameStatus::INCOMPLETE) break;
+            if (status == NetProtocol::FrameStatus::MALFORMED || type != NetProtocol::MessageType::SNAPSHOT) {
+                std::cerr << client.name << ": unexpected frame" << std::endl;
+                return false;
+            }
+            offset += consumed;
+
+            std::uint32_t baseId = 0;
+            const NetProtocol::Snapshot* base = nullptr;
+            if (!NetProtocol::peekBaseId(payload, payloadSize, baseId)) return false;
+            if (baseId != 0) {
+                auto found = client.received.find(baseId);
+                if (found == client.received.end()) {
+                    std::cerr << client.name << ": delta against unknown snapshot " << baseId << std::endl;
+                    return false;
+                }
+                base = &found->second;
+            }
+
+            NetProtocol::Snapshot snapshot;
+            if (!NetProtocol::readSnapshot(payload, payloadSize, base, snapshot)) {
+                std::cerr << client.name << ": malformed snapshot" << std::endl;
+                return false;
+            }
+            auto expected = client.expected.find(snapshot.tick);
+            if (expected == client.expected.end() || !sameState(snapshot, expected->second)) {
+                std::cerr << client.name << ": snapshot " << snapshot.id << " (base " << baseId
+                          << ") does not match the session at tick " << snapshot.tick << std::endl;
+                return false;
+            }
+            client.expected.erase(client.expected.begin(), ++expected);
+
+            if (baseId != 0) client.deltas++;
+            client.arrivals.push_back({snapshot.id, baseId});
+            client.received[snapshot.id] = std::move(snapshot);
+        }
+        client.inbox.erase(client.inbox.begin(), client.inbox.begin() + offset);
+        return true;
+    }
+
+    // Runs the server until it has accepted `count` clients.
+    bool acceptUpTo(GameServer& server, std::size_t count) {
+        for (int pass = 0; pass < 100 && server.getClientCount() < count; ++pass) {
+            if (!server.poll()) return false;
+        }
+        return server.getClientCount() == count;
+    }
+}
+
+int main() {
+    GameServer::Config config;
+    config.tickRate = TICK_RATE;
+    GameServer server(config);
+
+    const std::string path = "/tmp/maze_loopback_" + std::to_string(getpid()) + ".sock";
+    if (!server.listenUnix(path) || !server.listenTcp(0)) {
+        return 1;
+    }
+
+    // Connected one at a time so server client i is clients[i].
+    LoopbackClient clients[2] = {LoopbackClient("unix"), LoopbackClient("tcp")};
+    clients[0].fd = connectUnix(path);
+    if (clients[0].fd < 0 || !acceptUpTo(server, 1)) {
+        std::cerr << "Could not connect over unix:" << path << std::endl;
+        return 1;
+    }
+    clients[1].fd = connectTcp(server.getTcpPort());
+    if (clients[1].fd < 0 || !acceptUpTo(server, 2)) {
+        std::cerr << "Could not connect to 127.0.0.1:" << server.getTcpPort() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::uint8_t> message;
+    for (auto& client : clients) {
+        message.clear();
+        NetProtocol::writeHello(GameSession::Difficulty::MEDIUM, message);
+        if (!sendAll(client.fd, message)) return 1;
+    }
+
+    // The unix client acks everything and keeps moving. The tcp client acks
+    // its first snapshots, pauses, then acks snapshot 1, long since evicted.
+    enum class Phase { ACKING, PAUSED, FALLBACK, RECOVERING, DONE };
+    Phase phase = Phase::ACKING;
+    std::uint32_t pausedBase = 0;
+    bool keptBase = false;
+    std::size_t fallbackWait = 0;
+    std::mt19937 rng(7);
+
+    while (server.getTickCount() < MAX_TICKS) {
+        std::uint32_t tick = server.getTickCount();
+        if (!server.poll()) return 1;
+        if (server.getTickCount() != tick) {
+            for (std::size_t i = 0; i < 2; ++i) {
+                clients[i].expected[server.getTickCount()] = fullSnapshot(server.getSession(i), server.getTickCount());
+            }
+        }
+
+        for (auto& client : clients) {
+            client.arrivals.clear();
+            if (!drain(client)) return 1;
+        }
+
+        for (const auto& arrival : clients[0].arrivals) {
+            if (!sendAck(clients[0], arrival.first)) return 1;
+            if (arrival.first % 4 == 0) {
+                message.clear();
+                NetProtocol::writeInput({static_cast<GameSession::Action>(1 + rng() % 4)}, message);
+                if (!sendAll(clients[0].fd, message)) return 1;
+            }
+        }
+
+        for (const auto& arrival : clients[1].arrivals) {
+            std::uint32_t id = arrival.first;
+            std::uint32_t baseId = arrival.second;
+            switch (phase) {
+                case Phase::ACKING:
+                    if (!sendAck(clients[1], id)) return 1;
+                    if (id >= 8) {
+                        pausedBase = id;
+                        phase = Phase::PAUSED;
+                    }
+                    break;
+                case Phase::PAUSED:
+                    if (id > pausedBase + config.snapshotHistory && baseId == pausedBase) {
+                        keptBase = true;
+                    }
+                    if (id > pausedBase + config.snapshotHistory + 4) {
+                        if (!sendAck(clients[1], 1)) return 1;
+                        phase = Phase::FALLBACK;
+                    }
+                    break;
+                case Phase::FALLBACK:
+                    if (baseId == 0) {
+                        if (!sendAck(clients[1], id)) return 1;
+                        phase = Phase::RECOVERING;
+                    } else if (++fallbackWait > 8) {
+                        std::cerr << "tcp: acking an evicted snapshot did not produce a full snapshot" << std::endl;
+                        return 1;
+                    }
+                    break;
+                case Phase::RECOVERING:
+                    if (!sendAck(clients[1], id)) return 1;
+                    if (baseId != 0) phase = Phase::DONE;
+                    break;
+                case Phase::DONE:
+                    break;
+            }
+        }
+
+        if (phase == Phase::DONE && clients[0].deltas >= 50) {
+            break;
+        }
+    }
+
+    if (phase != Phase::DONE || clients[0].deltas < 50) {
+        std::cerr << "Timed out after " << server.getTickCount() << " ticks" << std::endl;
+        return 1;
+    }
+    if (!keptBase) {
+        std::cerr << "tcp: deltas stopped using the acked base once it aged past the history" << std::endl;
+        return 1;
+    }
+    std::cout << "OK: " << clients[0].received.size() << " unix and " << clients[1].received.size()
+              << " tcp snapshots, " << clients[0].deltas + clients[1].deltas << " deltas, full fallback verified"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,28 @@
+// telemetry_decode.cpp
+// Prints a binary telemetry log written with --telemetry as one line per event.
+#include "Telemetry.hpp"
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: telemetry_decode <log file>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Could not open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    bool ok = Telemetry::decode(in, [](const Telemetry::Event& event) {
+        std::cout << event.timestamp / 1000.0 << "ms " << Telemetry::typeName(event.type) << " "
+                  << event.a << " " << event.b << " " << event.c << "\n";
+    });
+    if (!ok) {
+        std::cerr << "Malformed telemetry log" << std::endl;
+        return 1;
+    }
+    return 0;
+}
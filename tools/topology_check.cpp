@@ -0,0 +1,171 @@
+// topology_check.cpp
+// Generates and solves mazes on every grid topology. Each generated maze must
+// be perfect: cells - 1 passages, every passage open from both sides (the
+// opposite of direction d is d ^ 1), nothing open past the edge, and every
+// cell reachable, with solve() agreeing with a flood fill. Square mazes are
+// also rasterized, and the grid must hold exactly the same passages, at
+// twice the distance.
+#include "GridTopology.hpp"
+#include <bitset>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    const int SEEDS = 5;
+
+    int fail(const char* name, unsigned seed, const char* what) {
+        std::cerr << name << ", seed " << seed << ": " << what << std::endl;
+        return 1;
+    }
+
+    // Distance from the first cell to every cell, following open passages.
+    template<typename Topology>
+    std::vector<int> flood(const TopologyMaze<Topology>& maze) {
+        std::vector<int> distance(maze.getCellCount(), -1);
+        std::vector<std::size_t> queue(1, 0);
+        distance[0] = 0;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            GridCoord cell = maze.coord(queue[head]);
+            for (int d = 0; d < Topology::DIRECTIONS; ++d) {
+                if (!maze.isValidMove(cell, d)) continue;
+                std::size_t next = maze.index(TopologyMaze<Topology>::neighbor(cell, d));
+                if (distance[next] < 0) {
+                    distance[next] = distance[queue[head]] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+        return distance;
+    }
+
+    template<typename Topology>
+    int checkMaze(const char* name, unsigned seed, const TopologyMaze<Topology>& maze, bool perfect) {
+        std::size_t passages = 0;
+        for (std::size_t i = 0; i < maze.getCellCount(); ++i) {
+            GridCoord cell = maze.coord(i);
+            std::uint8_t open = maze.getPassages(cell);
+            passages += std::bitset<8>(open).count();
+            for (int d = 0; d < Topology::DIRECTIONS; ++d) {
+                GridCoord next = TopologyMaze<Topology>::neighbor(cell, d);
+                if (maze.contains(next) && TopologyMaze<Topology>::neighbor(next, d ^ 1) != cell) {
+                    return fail(name, seed, "direction d ^ 1 does not lead back");
+                }
+                if (!((open >> d) & 1)) continue;
+                if (!maze.contains(next)) return fail(name, seed, "passage leads off the grid");
+                if (!maze.isValidMove(next, d ^ 1)) return fail(name, seed, "passage is open from one side only");
+            }
+            if (open >> Topology::DIRECTIONS) return fail(name, seed, "passage bit past the last direction");
+        }
+        passages /= 2;
+        if (perfect ? passages != maze.getCellCount() - 1 : passages < maze.getCellCount() - 1) {
+            return fail(name, seed, "wrong passage count");
+        }
+
+        LinearArena scratch;
+        std::vector<int> distance = flood(maze);
+        for (std::size_t i = 0; i < maze.getCellCount(); ++i) {
+            if (distance[i] < 0) return fail(name, seed, "cell not reachable");
+            if (maze.solve(GridCoord(), maze.coord(i), scratch) != distance[i]) {
+                return fail(name, seed, "solve() disagrees with the flood fill");
+            }
+        }
+        return 0;
+    }
+
+    template<typename Topology>
+    int checkTopology(const char* name, int width, int height, int depth) {
+        int failures = 0;
+        LinearArena scratch;
+        for (unsigned seed = 1; seed <= SEEDS; ++seed) {
+            TopologyMaze<Topology> maze(width, height, depth);
+            std::mt19937 rng(seed);
+            maze.generate(rng, scratch, maze.coord(rng() % maze.getCellCount()));
+            failures += checkMaze(name, seed, maze, true);
+
+            maze.addOpenings(width * height * depth / 10, rng);
+            failures += checkMaze(name, seed, maze, false);
+        }
+        return failures;
+    }
+
+    int checkRasterize() {
+        int failures = 0;
+        LinearArena scratch;
+        for (unsigned seed = 1; seed <= SEEDS; ++seed) {
+            TopologyMaze<SquareTopology> maze(23, 17);
+            std::mt19937 rng(seed);
+            maze.generate(rng, scratch);
+            maze.addOpenings(20, rng);
+            std::vector<std::vector<char>> grid = rasterize(maze);
+            if (grid.size() != 35 || grid[0].size() != 47) {
+                failures += fail("rasterize", seed, "wrong grid size");
+                continue;
+            }
+
+            // Read the passages back out of the grid
+            TopologyMaze<SquareTopology> restored(maze.getWidth(), maze.getHeight());
+            for (int y = 0; y < maze.getHeight(); ++y) {
+                for (int x = 0; x < maze.getWidth(); ++x) {
+                    if (grid[2 * y + 1][2 * x + 1] != ' ') failures += fail("rasterize", seed, "cell is a wall");
+                    if (x + 1 < maze.getWidth() && grid[2 * y + 1][2 * x + 2] == ' ') restored.carve(GridCoord(x, y), 3);
+                    if (y + 1 < maze.getHeight() && grid[2 * y + 2][2 * x + 1] == ' ') restored.carve(GridCoord(x, y), 1);
+                }
+            }
+            for (std::size_t i = 0; i < maze.getCellCount(); ++i) {
+                if (restored.getPassages(maze.coord(i)) != maze.getPassages(maze.coord(i))) {
+                    failures += fail("rasterize", seed, "passages do not round-trip");
+                    break;
+                }
+            }
+            for (std::size_t y = 0; y < grid.size(); ++y) {
+                for (std::size_t x = 0; x < grid[y].size(); ++x) {
+                    bool edge = y == 0 || x == 0 || y + 1 == grid.size() || x + 1 == grid[y].size();
+                    bool post = y % 2 == 0 && x % 2 == 0;
+                    if ((edge || post) && grid[y][x] != '#') {
+                        failures += fail("rasterize", seed, "outer wall or wall post is open");
+                        y = grid.size() - 1;
+                        break;
+                    }
+                }
+            }
+
+            // A flood fill on the grid must take two steps per maze step
+            std::vector<int> distance = flood(maze);
+            std::vector<std::vector<int>> gridDistance(grid.size(), std::vector<int>(grid[0].size(), -1));
+            std::vector<std::pair<int, int>> queue(1, std::make_pair(1, 1));
+            gridDistance[1][1] = 0;
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                int x = queue[head].first;
+                int y = queue[head].second;
+                for (const GridOffset& offset : SquareTopology::OFFSETS[0]) {
+                    int nx = x + offset.dx;
+                    int ny = y + offset.dy;
+                    if (grid[ny][nx] == '#' || gridDistance[ny][nx] >= 0) continue;
+                    gridDistance[ny][nx] = gridDistance[y][x] + 1;
+                    queue.push_back(std::make_pair(nx, ny));
+                }
+            }
+            for (std::size_t i = 0; i < maze.getCellCount(); ++i) {
+                GridCoord cell = maze.coord(i);
+                if (gridDistance[2 * cell.y + 1][2 * cell.x + 1] != 2 * distance[i]) {
+                    failures += fail("rasterize", seed, "grid distance is not twice the maze distance");
+                    break;
+                }
+            }
+        }
+        return failures;
+    }
+}
+
+int main() {
+    int failures = 0;
+    failures += checkTopology<SquareTopology>("square", 40, 30, 1);
+    failures += checkTopology<HexTopology>("hex", 31, 17, 1);
+    failures += checkTopology<StackedTopology>("stacked", 12, 10, 5);
+    failures += checkRasterize();
+
+    std::cout << (failures == 0 ? "OK" : "FAILED") << ": square, hex and stacked mazes, " << SEEDS
+              << " seeds each" << std::endl;
+    return failures == 0 ? 0 : 1;
+}